@@ -0,0 +1,133 @@
+// Compares the representations of large cyclic rings. Build with
+// optimisations, e.g. -DCMAKE_BUILD_TYPE=Release, for meaningful numbers, and
+// with -march=native to let the residue lanes use the widest vector units.
+
+#include <CryptoCom/CyclicRing.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+
+
+template <std::size_t Bits>
+struct LimbRingTraits {
+  using PrimaryType = CryptoCom::FixedUInt<Bits>;
+  using EscalationType = CryptoCom::FixedUInt<2 * Bits>;
+  using CoefficientType = CryptoCom::FixedInt<Bits + 64>;
+  using Reduction = CryptoCom::MontgomeryReduction;
+
+  // The largest primes below 2^255 and 2^2047, 2^255 - 19 and 2^2047 - 85.
+  static constexpr PrimaryType Order =
+      (PrimaryType(1) << int(Bits - 1)) - (Bits == 256 ? 19 : 85);
+  static constexpr PrimaryType Generator{2};
+  static constexpr PrimaryType AdditiveIdentity{0};
+  static constexpr PrimaryType MultiplicativeIdentity{1};
+};
+
+template <std::size_t Bits>
+constexpr typename LimbRingTraits<Bits>::PrimaryType
+    LimbRingTraits<Bits>::Order;
+template <std::size_t Bits>
+constexpr typename LimbRingTraits<Bits>::PrimaryType
+    LimbRingTraits<Bits>::Generator;
+template <std::size_t Bits>
+constexpr typename LimbRingTraits<Bits>::PrimaryType
+    LimbRingTraits<Bits>::AdditiveIdentity;
+template <std::size_t Bits>
+constexpr typename LimbRingTraits<Bits>::PrimaryType
+    LimbRingTraits<Bits>::MultiplicativeIdentity;
+
+
+template <std::size_t Bits>
+struct ResidueRingTraits : public LimbRingTraits<Bits> {
+  using Reduction = CryptoCom::ResidueNumberSystem;
+};
+
+
+template <std::size_t Bits>
+struct SpecialFormRingTraits : public LimbRingTraits<Bits> {
+  using Reduction = CryptoCom::SpecialFormReduction;
+};
+
+
+// The same orders, installed at run time.
+template <std::size_t Bits>
+struct RunTimeRingTraits
+    : public CryptoCom::DynamicRingTraits<RunTimeRingTraits<Bits>,
+          CryptoCom::FixedUInt<Bits>, CryptoCom::FixedUInt<2 * Bits>,
+          CryptoCom::FixedInt<Bits + 64>> {};
+
+
+template <typename Traits>
+typename Traits::PrimaryType RandomElement(std::mt19937_64& engine) {
+  typename Traits::PrimaryType result;
+  for (std::size_t idx = 0; idx < Traits::PrimaryType::LimbCount; ++idx)
+    result.data()[idx] = engine();
+  return result % Traits::Order;
+}
+
+
+template <typename Action>
+double MicrosecondsPer(int const repetitions, Action action) {
+  auto const start = std::chrono::steady_clock::now();
+  for (int idx = 0; idx < repetitions; ++idx)
+    action();
+  std::chrono::duration<double, std::micro> const elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / repetitions;
+}
+
+
+template <typename Traits>
+void Measure(std::string const& name, int const repetitions) {
+  using Ring = CryptoCom::CyclicRing<Traits>;
+  std::mt19937_64 engine;
+  // Short exponents, as drawn for ElGamal keys and nonces.
+  using PrimaryType = typename Traits::PrimaryType;
+  constexpr int bits = std::numeric_limits<PrimaryType>::digits;
+  auto const exponent = RandomElement<Traits>(engine) >> (bits - 256);
+  Ring x{RandomElement<Traits>(engine)};
+  Ring const y{RandomElement<Traits>(engine)};
+
+  auto const multiply =
+      MicrosecondsPer(repetitions, [&x, &y]() { x = x * y; });
+  auto const square =
+      MicrosecondsPer(repetitions, [&x]() { x = x.square(); });
+  auto const pow = MicrosecondsPer(
+      repetitions / 1000 + 1, [&x, &exponent]() { x = x.pow(exponent); });
+  Ring::GeneratorPow(exponent);
+  auto const fixedBase = MicrosecondsPer(repetitions / 1000 + 1,
+      [&x, &exponent]() { x = x * Ring::GeneratorPow(exponent); });
+
+  std::cout << std::setw(16) << std::left << name << std::right
+            << std::setw(12) << multiply << std::setw(12) << square
+            << std::setw(14) << pow << std::setw(14) << fixedBase << "  ("
+            << x.ordinalIndex().data()[0] % 10 << ")\n";
+}
+
+
+int main() {
+  std::cout << std::fixed << std::setprecision(3) << std::setw(16)
+            << std::left << "microseconds" << std::right << std::setw(12)
+            << "multiply" << std::setw(12) << "square" << std::setw(14)
+            << "pow" << std::setw(14) << "fixed base" << "\n";
+
+  CryptoCom::DynamicRingContext<RunTimeRingTraits<256>>::Install(
+      LimbRingTraits<256>::Order, LimbRingTraits<256>::Generator);
+  CryptoCom::DynamicRingContext<RunTimeRingTraits<2048>>::Install(
+      LimbRingTraits<2048>::Order, LimbRingTraits<2048>::Generator);
+
+  Measure<LimbRingTraits<256>>("limbs 256", 200000);
+  Measure<SpecialFormRingTraits<256>>("special 256", 200000);
+  Measure<RunTimeRingTraits<256>>("run time 256", 200000);
+  Measure<ResidueRingTraits<256>>("residues 256", 200000);
+  Measure<LimbRingTraits<2048>>("limbs 2048", 20000);
+  Measure<SpecialFormRingTraits<2048>>("special 2048", 20000);
+  Measure<RunTimeRingTraits<2048>>("run time 2048", 20000);
+  Measure<ResidueRingTraits<2048>>("residues 2048", 20000);
+  return 0;
+}
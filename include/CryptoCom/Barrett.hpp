@@ -0,0 +1,94 @@
+#pragma once
+
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Reduction.hpp>
+
+namespace CryptoCom {
+
+  namespace detail {
+
+    // Reduces any value below order^2, given the reciprocal
+    // floor(4^k / order) of a k bit order. Both the shifted value and the
+    // reciprocal fit into a word, so the quotient estimate is a single word
+    // by word multiplication; it is off by at most two.
+    template <typename Word, typename DoubleWord>
+    constexpr Word BarrettReduce(DoubleWord const value, Word const order,
+        int const orderBits, Word const reciprocal) {
+      auto const shifted = Word(value >> (orderBits - 1));
+      auto const quotient =
+          Word((DoubleWord(shifted) * reciprocal) >> (orderBits + 1));
+      auto remainder = value - DoubleWord(quotient) * order;
+      while (remainder >= order)
+        remainder -= order;
+      return Word(remainder);
+    }
+
+  } // namespace detail
+
+
+  // Barrett reduction replaces the division of a double-width product by a
+  // multiplication with the reciprocal floor(4^k / Order), where k is the
+  // bit length of the order. The reciprocal is derived at compile time, and
+  // unlike Montgomery form the residues stay canonical, so it works for even
+  // orders as well.
+  template <typename RingTraits>
+  struct ReductionKernel<BarrettReduction, RingTraits>
+      : detail::ModularAddition<RingTraits> {
+    using PrimaryType = typename RingTraits::PrimaryType;
+    using EscalationType = typename RingTraits::EscalationType;
+    using Representation = PrimaryType;
+
+    using Word = typename detail::UnsignedOf<PrimaryType>::type;
+    using DoubleWord = typename detail::UnsignedOf<EscalationType>::type;
+
+    static constexpr Word Order = Word(RingTraits::Order);
+    static constexpr int OrderBits = detail::BitLength(Order);
+
+    static_assert(detail::Digits<DoubleWord>::value >=
+                      2 * detail::Digits<Word>::value,
+        "Barrett reduction needs an EscalationType twice as wide as the "
+        "PrimaryType");
+
+    static constexpr DoubleWord Reciprocal =
+        (DoubleWord(1) << (2 * OrderBits)) / Order;
+
+    static_assert(Reciprocal <= detail::MaxOf<Word>(),
+        "the Barrett reciprocal of the order has to fit into a word");
+
+
+    static constexpr Word Reduce(DoubleWord const value) {
+      return detail::BarrettReduce(value, Order, OrderBits, Word(Reciprocal));
+    }
+
+    static constexpr Representation FromInteger(PrimaryType const value) {
+      return detail::ModularAddition<RingTraits>::Canonical(value);
+    }
+
+    static constexpr PrimaryType ToInteger(Representation const value) {
+      return value;
+    }
+
+    static constexpr Representation Multiply(
+        Representation const lhs, Representation const rhs) {
+      return Representation(Reduce(DoubleWord(Word(lhs)) * Word(rhs)));
+    }
+
+    static constexpr Representation Square(Representation const value) {
+      return Multiply(value, value);
+    }
+
+    // The quotient estimate stays within two of the quotient for any value
+    // below 4^k, not just for products, which leaves LazyAccumulator some
+    // headroom whenever the order is well below 2^k.
+    static constexpr DoubleWord ProductBound() {
+      return 2 * OrderBits < detail::Digits<DoubleWord>::value
+                 ? (DoubleWord(1) << (2 * OrderBits)) - 1
+                 : detail::MaxOf<DoubleWord>();
+    }
+
+    static constexpr Representation ReduceProduct(DoubleWord const value) {
+      return Representation(Reduce(value));
+    }
+  };
+
+} // namespace CryptoCom
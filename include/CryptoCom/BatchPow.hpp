@@ -0,0 +1,342 @@
+#pragma once
+
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/Exponent.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Montgomery.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <CryptoCom/RingVector.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+namespace CryptoCom {
+  namespace detail {
+
+    // Residues of an odd modulus below 2^51 in 52 bit Montgomery form,
+    // x * 2^52 mod m, for the 52 bit multipliers of AVX-512 IFMA. The bound
+    // keeps the unreduced REDC result below 2^52.
+    constexpr int WideLaneBits = 52;
+    constexpr std::uint64_t WideLaneMask =
+        (std::uint64_t(1) << WideLaneBits) - 1;
+
+    struct WideLaneModulus {
+      std::uint64_t modulus;
+      std::uint64_t negInverse;
+      std::uint64_t rSquared;
+
+      explicit constexpr WideLaneModulus(std::uint64_t const value)
+          : modulus(value)
+          , negInverse(MontgomeryNegInverse(value) & WideLaneMask)
+          , rSquared(std::uint64_t(
+                ((UInt128(1) << WideLaneBits) % value) *
+                ((UInt128(1) << WideLaneBits) % value) % value)) {}
+    };
+
+
+    // a * b / 2^52 mod m for a, b below m.
+    constexpr std::uint64_t WideLaneMultiply(std::uint64_t const a,
+        std::uint64_t const b, WideLaneModulus const& m) {
+      auto const t = UInt128(a) * b;
+      auto const q = (std::uint64_t(t) * m.negInverse) & WideLaneMask;
+      auto const u =
+          std::uint64_t((t + UInt128(q) * m.modulus) >> WideLaneBits);
+      return u >= m.modulus ? u - m.modulus : u;
+    }
+
+
+#if defined(__x86_64__)
+    CRYPTOCOM_BEGIN_AVX512_KERNELS
+
+    // Eight 52 bit lanes per register. IFMA multiplies the low 52 bits of
+    // two lanes and adds either half of the 104 bit product to a third,
+    // so the REDC's low halves cancel into a carry bit and its high halves
+    // are the result.
+    __attribute__((target("avx512f,avx512ifma"))) inline __m512i
+    WideLaneMultiplyIfma(__m512i const a, __m512i const b,
+        __m512i const modulus, __m512i const negInverse) {
+      auto const zero = _mm512_setzero_si512();
+      auto const low = _mm512_madd52lo_epu64(zero, a, b);
+      auto const high = _mm512_madd52hi_epu64(zero, a, b);
+      auto const q = _mm512_madd52lo_epu64(zero, low, negInverse);
+      auto const sumLow = _mm512_madd52lo_epu64(low, q, modulus);
+      auto const sumHigh = _mm512_madd52hi_epu64(high, q, modulus);
+      auto const u =
+          _mm512_add_epi64(sumHigh, _mm512_srli_epi64(sumLow, WideLaneBits));
+      return _mm512_min_epu64(u, _mm512_sub_epi64(u, modulus));
+    }
+
+    __attribute__((target("avx512f,avx512ifma"))) inline void
+    WideLaneMultiplyAllIfma(std::uint64_t* out, std::uint64_t const* a,
+        std::uint64_t const* b, std::size_t const count,
+        WideLaneModulus const& m) {
+      constexpr std::size_t Width = 8;
+      auto const modulus = _mm512_set1_epi64((long long)m.modulus);
+      auto const negInverse = _mm512_set1_epi64((long long)m.negInverse);
+      std::size_t idx = 0;
+      for (; idx + Width <= count; idx += Width) {
+        _mm512_storeu_si512(out + idx,
+            WideLaneMultiplyIfma(_mm512_loadu_si512(a + idx),
+                _mm512_loadu_si512(b + idx), modulus, negInverse));
+      }
+      for (; idx < count; ++idx)
+        out[idx] = WideLaneMultiply(a[idx], b[idx], m);
+    }
+
+    CRYPTOCOM_END_AVX512_KERNELS
+#endif
+
+
+    inline bool HasIfma() {
+#if defined(__x86_64__)
+      static bool const supported = []() {
+        __builtin_cpu_init();
+        return __builtin_cpu_supports("avx512f") &&
+               __builtin_cpu_supports("avx512ifma");
+      }();
+      return supported;
+#else
+      return false;
+#endif
+    }
+
+
+    // Whether the elements of a ring fit the 52 bit lanes but not the 32
+    // bit ones, which hold twice as many per register.
+    template <typename RingTraits>
+    struct HasWideLaneOrder
+        : std::integral_constant<bool,
+              !HasLaneOrder<RingTraits>::value &&
+                  FitsLanes<RingTraits, WideLaneBits - 1>::value> {};
+
+
+    // The 52 bit lanes, with the interface of RingVectorElements which
+    // the lockstep exponentiation needs.
+    template <typename RingTraits>
+    struct WideLaneElements {
+      using Ring = CyclicRing<RingTraits>;
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using Element = std::uint64_t;
+
+      static WideLaneModulus const& Modulus() {
+        static constexpr WideLaneModulus modulus{
+            std::uint64_t(RingTraits::Order)};
+        return modulus;
+      }
+
+      static Element FromRing(Ring const& value) {
+        return WideLaneMultiply(std::uint64_t(value.ordinalIndex()),
+            Modulus().rSquared, Modulus());
+      }
+
+      static Ring ToRing(Element const value) {
+        return Ring{PrimaryType(WideLaneMultiply(value, 1, Modulus()))};
+      }
+
+      static void Multiply(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+#if defined(__x86_64__)
+        WideLaneMultiplyAllIfma(out, a, b, count, Modulus());
+#else
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = WideLaneMultiply(a[idx], b[idx], Modulus());
+#endif
+      }
+    };
+
+
+    // Exponents are processed in windows of BatchPowWindow bits and bases
+    // in chunks of BatchPowChunk, whose window tables stay in the L1 cache.
+    constexpr int BatchPowWindow = 4;
+    constexpr std::size_t BatchPowChunk = 256;
+
+
+    // Fixed window exponentiation of many bases in lockstep: every step
+    // squares all of the intermediate results, or multiplies each by the
+    // table entry its exponent selects, with one call of the element-wise
+    // kernels. Every base is raised to the length of the longest exponent.
+    template <typename Elements, typename IntegralType>
+    void LockstepPow(typename Elements::Ring* values,
+        IntegralType const* exponents, std::size_t const count) {
+      using Element = typename Elements::Element;
+      using Bits = ExponentBits<IntegralType>;
+      constexpr std::size_t Digits = std::size_t(1) << BatchPowWindow;
+
+      std::vector<Bits> bits;
+      bits.reserve(count);
+      int length = 0;
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        bits.emplace_back(exponents[idx]);
+        length = std::max(length, bits.back().length());
+      }
+
+      // table[d count + i] = values[i]^d
+      std::vector<Element> table(Digits * count);
+      auto const one = Elements::FromRing(Elements::Ring::One());
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        table[idx] = one;
+        table[count + idx] = Elements::FromRing(values[idx]);
+      }
+      for (std::size_t digit = 2; digit < Digits; ++digit) {
+        Elements::Multiply(&table[digit * count],
+            &table[(digit - 1) * count], &table[count], count);
+      }
+
+      auto const select = [&](int const window, Element* out) {
+        auto const low = window * BatchPowWindow;
+        auto const high =
+            std::min(low + BatchPowWindow, int(Bits::MaxLength)) - 1;
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = table[bits[idx].window(high, low) * count + idx];
+      };
+
+      std::vector<Element> result(count, one), selected(count);
+      if (length > 0) {
+        auto window = (length - 1) / BatchPowWindow;
+        select(window, result.data());
+        while (window-- > 0) {
+          for (int bit = 0; bit < BatchPowWindow; ++bit) {
+            Elements::Multiply(
+                result.data(), result.data(), result.data(), count);
+          }
+          select(window, selected.data());
+          Elements::Multiply(
+              result.data(), result.data(), selected.data(), count);
+        }
+      }
+
+      for (std::size_t idx = 0; idx < count; ++idx)
+        values[idx] = Elements::ToRing(result[idx]);
+    }
+
+
+    template <typename Elements, typename IntegralType>
+    void LockstepPowChunked(typename Elements::Ring* values,
+        IntegralType const* exponents, std::size_t const count) {
+      for (std::size_t first = 0; first < count; first += BatchPowChunk) {
+        LockstepPow<Elements>(values + first, exponents + first,
+            std::min(BatchPowChunk, count - first));
+      }
+    }
+
+
+    template <typename Ring, typename IntegralType>
+    void PowEach(
+        Ring* values, IntegralType const* exponents, std::size_t const count) {
+      for (std::size_t idx = 0; idx < count; ++idx)
+        values[idx] = values[idx].pow(exponents[idx]);
+    }
+
+
+    // Raises values[i] to exponents[i], the lanes of the widest vector unit
+    // the ring's order and the processor allow, one at a time otherwise.
+    template <typename RingTraits, typename IntegralType>
+    void PowAll(CyclicRing<RingTraits>* values, IntegralType const* exponents,
+        std::size_t const count, std::false_type /* wide lanes */) {
+      if (HasLaneOrder<RingTraits>::value &&
+          SupportedLaneWidth() != LaneWidth::Scalar) {
+        return LockstepPowChunked<RingVectorElements<RingTraits>>(
+            values, exponents, count);
+      }
+      PowEach(values, exponents, count);
+    }
+
+    template <typename RingTraits, typename IntegralType>
+    void PowAll(CyclicRing<RingTraits>* values, IntegralType const* exponents,
+        std::size_t const count, std::true_type /* wide lanes */) {
+      if (HasIfma()) {
+        return LockstepPowChunked<WideLaneElements<RingTraits>>(
+            values, exponents, count);
+      }
+      PowEach(values, exponents, count);
+    }
+
+
+    template <typename RingTraits>
+    typename RingTraits::PrimaryType PlainExponent(
+        CyclicRing<RingTraits> const& exponent) {
+      return exponent.exponent();
+    }
+
+    template <typename IntegralType>
+    IntegralType PlainExponent(IntegralType const& exponent) {
+      return exponent;
+    }
+
+    template <typename IntegralType>
+    typename std::enable_if<std::is_signed<IntegralType>::value, bool>::type
+    IsNegative(IntegralType const exponent) {
+      return exponent < 0;
+    }
+
+    template <typename IntegralType>
+    typename std::enable_if<!std::is_signed<IntegralType>::value, bool>::type
+    IsNegative(IntegralType const&) {
+      return false;
+    }
+
+  } // namespace detail
+
+
+  // base ^ exponent for every base of [first, last) and the exponent at the
+  // same position from `exponents`, which are integers or ring elements as
+  // for CyclicRing::pow. Independent exponentiations run side by side in
+  // the lanes of the vector units: rings of an odd order below 2^31 use the
+  // 32 bit lanes of RingVector with AVX-512 or AVX2, those below 2^51 the
+  // 52 bit lanes of AVX-512 IFMA, and all others, or processors without
+  // these units, exponentiate one base after the other. Negative exponents
+  // are inverted with a single BatchInverse.
+  template <typename InputIt, typename ExponentIt>
+  std::vector<typename std::iterator_traits<InputIt>::value_type> BatchPow(
+      InputIt first, InputIt last, ExponentIt exponents) {
+    using Ring = typename std::iterator_traits<InputIt>::value_type;
+    using Traits = typename Ring::Traits;
+    using Exponent = decltype(detail::PlainExponent(*exponents));
+
+    std::vector<Ring> values(first, last);
+    std::vector<Exponent> plainExponents;
+    std::vector<std::size_t> negatives;
+    plainExponents.reserve(values.size());
+    for (std::size_t idx = 0; idx < values.size(); ++idx, ++exponents) {
+      auto const exponent = detail::PlainExponent(*exponents);
+      if (detail::IsNegative(exponent)) {
+        negatives.push_back(idx);
+        plainExponents.push_back(Exponent(std::abs(exponent)));
+      } else {
+        plainExponents.push_back(exponent);
+      }
+    }
+
+    detail::PowAll(values.data(), plainExponents.data(), values.size(),
+        detail::HasWideLaneOrder<Traits>{});
+
+    if (!negatives.empty()) {
+      std::vector<Ring> inverses;
+      for (auto const idx : negatives)
+        inverses.push_back(values[idx]);
+      BatchInverse(inverses.begin(), inverses.end());
+      for (std::size_t idx = 0; idx < negatives.size(); ++idx)
+        values[negatives[idx]] = inverses[idx];
+    }
+    return values;
+  }
+
+
+  template <typename Bases, typename Exponents>
+  std::vector<typename Bases::value_type> BatchPow(
+      Bases const& bases, Exponents const& exponents) {
+    if (bases.size() != exponents.size())
+      throw std::invalid_argument("as many exponents as bases are needed");
+    return BatchPow(bases.begin(), bases.end(), exponents.begin());
+  }
+
+} // namespace CryptoCom
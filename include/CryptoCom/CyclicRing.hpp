@@ -1,29 +1,92 @@
 #pragma once
 
+#include <CryptoCom/Barrett.hpp>
+#include <CryptoCom/DynamicRing.hpp>
 #include <CryptoCom/Eucledian.hpp>
+#include <CryptoCom/Exponent.hpp>
+#include <CryptoCom/FixedBase.hpp>
+#include <CryptoCom/Montgomery.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <CryptoCom/ResidueNumberSystem.hpp>
+#include <CryptoCom/SpecialForm.hpp>
 #include <cmath>
+#include <cstddef>
 #include <iostream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace CryptoCom {
 
+  template <typename Value, typename = void>
+  class LazyAccumulator;
+
+
   template <typename RingTraits>
   class CyclicRing {
-    typename RingTraits::PrimaryType ordinalIndex_;
+    using Arithmetic = ReductionOf<RingTraits>;
+    using Representation = typename Arithmetic::Representation;
+    using Storage =
+        typename detail::StorageOf<RingTraits, Representation>::type;
+
+    Storage ordinalIndex_;
+
+    // Tagged constructor for values already in the kernel's representation.
+    // The arithmetic operators build their results through it, so only
+    // integers coming from the outside are ever reduced by division.
+    struct FromRepresentation {};
+    constexpr CyclicRing(
+        FromRepresentation, Representation const& value) noexcept
+        : ordinalIndex_(Storage(value)) {}
+
+    // The kernel's representation of the element, widened from a narrower
+    // StorageType and referred to otherwise.
+    using Loaded = typename std::conditional<
+        std::is_same<Storage, Representation>::value, Representation const&,
+        Representation>::type;
+
+    constexpr Loaded representation() const { return ordinalIndex_; }
+
+    template <typename, typename>
+    friend class LazyAccumulator;
 
   public:
     using Traits = RingTraits;
 
     constexpr CyclicRing(
         typename Traits::PrimaryType const ordinalIndex) noexcept
-        : ordinalIndex_(
-              (typename Traits::EscalationType(Traits::Order) + ordinalIndex) %
-              Traits::Order) {}
+        : ordinalIndex_(Storage(Arithmetic::FromInteger(ordinalIndex))) {}
+
+    // Rings over a class type PrimaryType, such as FixedUInt, are still
+    // constructible from plain integers.
+    template <typename IntegralType,
+        typename = typename std::enable_if<
+            std::is_integral<IntegralType>::value &&
+            !std::is_integral<typename RingTraits::PrimaryType>::value>::type>
+    constexpr CyclicRing(IntegralType const ordinalIndex) noexcept
+        : CyclicRing(typename RingTraits::PrimaryType(ordinalIndex)) {}
 
     constexpr CyclicRing(const CyclicRing<Traits>& other) noexcept
         : ordinalIndex_(other.ordinalIndex_) {}
 
-    constexpr CyclicRing() noexcept : ordinalIndex_(Traits::AdditiveIdentity) {}
+    constexpr CyclicRing() noexcept
+        : CyclicRing(Traits::AdditiveIdentity) {}
+
+    // The canonical integer in [0, Order) this element stands for.
+    constexpr typename Traits::PrimaryType ordinalIndex() const {
+      return Arithmetic::ToInteger(representation());
+    }
+
+    // The element taken as an exponent. In a Schnorr group that is its
+    // ordinalIndex modulo the SubgroupOrder, which is all a power of an
+    // element of the subgroup depends on, so exponents drawn uniformly
+    // below the order shrink to the bit length of the subgroup order.
+    typename Traits::PrimaryType exponent() const {
+      return reducedExponent(detail::HasSubgroupOrder<Traits>{});
+    }
 
     static CyclicRing<Traits> constexpr Zero() {
       return CyclicRing<Traits>{Traits::AdditiveIdentity};
@@ -38,41 +101,45 @@ namespace CryptoCom {
     }
 
     bool operator==(CyclicRing const& other) const {
-      return ordinalIndex_ == other.ordinalIndex_;
+      return Arithmetic::Equal(representation(), other.representation());
     }
 
     bool operator!=(CyclicRing const& other) const {
-      return ordinalIndex_ != other.ordinalIndex_;
+      return !Arithmetic::Equal(representation(), other.representation());
     }
 
     bool operator<(CyclicRing const other) const {
-      return ordinalIndex_ < other.ordinalIndex_;
+      return Arithmetic::Less(representation(), other.representation());
     }
 
 
     CyclicRing<Traits> operator+(CyclicRing<Traits> const& other) const {
-      return CyclicRing<Traits>{
-          (ordinalIndex_ + other.ordinalIndex_) % Traits::Order};
+      return {FromRepresentation{},
+          Arithmetic::Add(representation(), other.representation())};
     }
 
     CyclicRing<Traits>& operator+=(CyclicRing<Traits> const& other) {
-      ordinalIndex_ = (ordinalIndex_ + other.ordinalIndex_) % Traits::Order;
+      ordinalIndex_ =
+          Storage(Arithmetic::Add(representation(), other.representation()));
       return *this;
     }
 
     CyclicRing<Traits> operator-() const {
-      return CyclicRing<Traits>{Traits::Order - ordinalIndex_};
+      return {FromRepresentation{}, Arithmetic::Negate(representation())};
     }
 
     CyclicRing<Traits> operator-(CyclicRing<Traits> const& other) const {
-      return *this + (-other);
+      return {FromRepresentation{},
+          Arithmetic::Subtract(representation(), other.representation())};
     }
 
     CyclicRing<Traits> operator*(CyclicRing<Traits> const& other) const {
-      typename Traits::EscalationType escalatedResults =
-          ordinalIndex_ * other.ordinalIndex_;
-      return static_cast<typename Traits::PrimaryType>(
-          escalatedResults % Traits::Order);
+      return {FromRepresentation{},
+          Arithmetic::Multiply(representation(), other.representation())};
+    }
+
+    CyclicRing<Traits> square() const {
+      return {FromRepresentation{}, Arithmetic::Square(representation())};
     }
 
     template <typename IntegralType>
@@ -81,15 +148,7 @@ namespace CryptoCom {
     pow(IntegralType exponent) const {
       if (exponent < 0)
         return pow(std::abs(exponent)).inverse();
-
-      if (exponent == 0)
-        return CyclicRing<Traits>::One();
-
-      if ((exponent % 2) == 1)
-        return *this * pow(exponent - 1);
-
-      auto const base{pow(exponent >> 1)};
-      return base * base;
+      return slidingWindowPow(exponent);
     }
 
 
@@ -97,17 +156,87 @@ namespace CryptoCom {
     typename std::enable_if<!std::is_signed<IntegralType>::value,
         CyclicRing<Traits>>::type
     pow(IntegralType exponent) const {
-      if (exponent == 0)
+      return slidingWindowPow(exponent);
+    }
+
+
+    CyclicRing<Traits> pow(CyclicRing<Traits> const& exponent) const {
+      return pow(exponent.exponent());
+    }
+
+
+    // this ^ Exponent for an exponent known at compile time, such as the
+    // Order - 2 of Fermat's inversion. The addition chain is derived while
+    // compiling and unrolled into its squarings and multiplications, with
+    // neither bits to scan nor branches to mispredict.
+    template <std::uint64_t Exponent>
+    CyclicRing<Traits> pow() const {
+      using Chain = detail::AdditionChain<Exponent>;
+      if (Exponent == 0)
         return CyclicRing<Traits>::One();
 
-      if ((exponent % 2) == 1)
-        return *this * pow(exponent - 1);
+      Representation oddPowers[Chain::Value.oddPowers > 0
+                                   ? Chain::Value.oddPowers
+                                   : 1];
+      oddPowers[0] = representation();
+      if (Chain::Value.oddPowers > 1) {
+        auto const square = Arithmetic::Square(representation());
+        for (int idx = 1; idx < Chain::Value.oddPowers; ++idx)
+          oddPowers[idx] = Arithmetic::Multiply(oddPowers[idx - 1], square);
+      }
+
+      auto result = oddPowers[Chain::Value.first];
+      chainSteps<Exponent>(
+          result, oddPowers, std::make_index_sequence<Chain::Value.count>{});
+      return {FromRepresentation{}, result};
+    }
+
+
+    // Generator() ^ exponent, looked up in the generator's fixed-base table.
+    template <typename IntegralType>
+    static CyclicRing<Traits> GeneratorPow(IntegralType const& exponent) {
+      return fixedBasePow(
+          detail::GeneratorPowers<Traits>::Get(), Generator(), exponent);
+    }
+
 
-      auto const base{pow(exponent >> 1)};
-      return base * base;
+    static CyclicRing<Traits> GeneratorPow(CyclicRing<Traits> const& exponent) {
+      return GeneratorPow(exponent.exponent());
     }
 
 
+    // Powers of a base known ahead of many exponentiations, such as an
+    // encryption key, from a fixed-base table built once. The table holds
+    // ceil(b / Width) (2^Width - 1) elements for a b bit order and a power
+    // costs a multiplication per Width bits of the exponent, so every bit
+    // of width halves the multiplications at twice the memory. Copies
+    // share the table.
+    template <int Width = detail::FixedBaseWidth>
+    class FixedBase {
+      using Table = detail::FixedBaseTable<Arithmetic, Width,
+          detail::OrderBits<Traits>::value>;
+
+      CyclicRing<Traits> base_;
+      std::shared_ptr<Table const> table_;
+
+    public:
+      explicit FixedBase(CyclicRing<Traits> const& base)
+          : base_(base)
+          , table_(std::make_shared<Table const>(base.representation())) {}
+
+      CyclicRing<Traits> const& base() const { return base_; }
+
+      template <typename IntegralType>
+      CyclicRing<Traits> pow(IntegralType const& exponent) const {
+        return fixedBasePow(*table_, base_, exponent);
+      }
+
+      CyclicRing<Traits> pow(CyclicRing<Traits> const& exponent) const {
+        return pow(exponent.exponent());
+      }
+    };
+
+
     template <typename IntegralType>
     CyclicRing<Traits> operator^(IntegralType exponent) const {
       return pow(exponent);
@@ -116,17 +245,16 @@ namespace CryptoCom {
 
     template <typename IntegralType>
     CyclicRing<Traits> operator%(IntegralType modulo) const {
-      return ordinalIndex_ % modulo;
+      return ordinalIndex() % modulo;
     }
 
     template <typename IntegralType>
     CyclicRing<Traits> operator>>(IntegralType value) const {
-      return ordinalIndex_ >> value;
+      return ordinalIndex() >> value;
     }
 
     CyclicRing<Traits> inverse() const {
-      return CyclicRing<Traits>{InverseModulo<typename Traits::PrimaryType,
-          typename Traits::CoefficientType>(ordinalIndex_, Traits::Order)};
+      return invert(detail::HasPrimeOrder<Traits>{});
     }
 
     CyclicRing<Traits> operator/(CyclicRing<Traits> const& other) const {
@@ -134,7 +262,168 @@ namespace CryptoCom {
     }
 
     friend std::ostream& operator<<(std::ostream&, CyclicRing<Traits> const&);
+
+  private:
+    typename Traits::PrimaryType reducedExponent(
+        std::false_type /* subgroup order */) const {
+      return ordinalIndex();
+    }
+
+    typename Traits::PrimaryType reducedExponent(
+        std::true_type /* subgroup order */) const {
+      return ordinalIndex() % detail::ExponentModulus<Traits>();
+    }
+
+    template <std::uint64_t Exponent, std::size_t... Steps>
+    static void chainSteps(Representation& result,
+        Representation const* oddPowers, std::index_sequence<Steps...>) {
+      int const unrolled[] = {0,
+          (result = chainStep<detail::AdditionChain<Exponent>::Value
+                                  .steps[Steps]>(result, oddPowers),
+              0)...};
+      (void)unrolled;
+    }
+
+    template <int Step>
+    static Representation chainStep(
+        Representation const& value, Representation const* oddPowers) {
+      return Step < 0 ? Arithmetic::Square(value)
+                      : Arithmetic::Multiply(value, oddPowers[Step]);
+    }
+
+    CyclicRing<Traits> invert(std::false_type /* prime order */) const {
+      return CyclicRing<Traits>{InverseModulo<typename Traits::PrimaryType,
+          typename Traits::CoefficientType>(ordinalIndex(), Traits::Order)};
+    }
+
+    // a^(p - 2) = a^-1 modulo a prime p, by the same multiplications as the
+    // rest of the ring's arithmetic and without leaving its representation.
+    CyclicRing<Traits> invert(std::true_type /* prime order */) const {
+      if (*this == Zero())
+        throw std::invalid_argument("relative primes have no inverse modulo");
+      return fermatPow(detail::HasConstantWordOrder<Traits>{});
+    }
+
+    // The exponent Order - 2 of a word sized order known at compile time
+    // is unrolled into its addition chain.
+    CyclicRing<Traits> fermatPow(std::true_type /* constant word */) const {
+      return pow<std::uint64_t(Traits::Order - 2)>();
+    }
+
+    CyclicRing<Traits> fermatPow(std::false_type /* constant word */) const {
+      return pow(typename Traits::PrimaryType(Traits::Order - 2));
+    }
+
+    // Exponents beyond the reach of the table fall back to the generic
+    // exponentiation, negative ones are inverted.
+    template <typename Table, typename IntegralType>
+    static typename std::enable_if<std::is_signed<IntegralType>::value,
+        CyclicRing<Traits>>::type
+    fixedBasePow(Table const& table, CyclicRing<Traits> const& base,
+        IntegralType const exponent) {
+      if (exponent < 0)
+        return fixedBasePow(table, base, std::abs(exponent)).inverse();
+      return fixedBaseLookup(table, base, exponent);
+    }
+
+    template <typename Table, typename IntegralType>
+    static typename std::enable_if<!std::is_signed<IntegralType>::value,
+        CyclicRing<Traits>>::type
+    fixedBasePow(Table const& table, CyclicRing<Traits> const& base,
+        IntegralType const& exponent) {
+      return fixedBaseLookup(table, base, exponent);
+    }
+
+    template <typename Table, typename IntegralType>
+    static CyclicRing<Traits> fixedBaseLookup(Table const& table,
+        CyclicRing<Traits> const& base, IntegralType const& exponent) {
+      detail::ExponentBits<IntegralType> const bits(exponent);
+      if (!Table::Covers(bits))
+        return base.pow(exponent);
+      auto const one = Arithmetic::FromInteger(Traits::MultiplicativeIdentity);
+      return {FromRepresentation{}, table.pow(bits, one)};
+    }
+
+
+    // Left-to-right sliding window exponentiation. The exponent is cut into
+    // windows of at most w bits which start and end with a set bit, each
+    // costing one multiplication with a precomputed odd power x, x^3, ...,
+    // x^(2^w - 1), while the zero bits in between cost squarings only.
+    template <typename IntegralType>
+    CyclicRing<Traits> slidingWindowPow(IntegralType const& exponent) const {
+      using Bits = detail::ExponentBits<IntegralType>;
+      constexpr std::size_t TableSize = std::size_t(1)
+          << (detail::SlidingWindowWidth(Bits::MaxLength) - 1);
+
+      Bits const bits(exponent);
+      auto const length = bits.length();
+      if (length == 0)
+        return CyclicRing<Traits>::One();
+
+      auto const width = detail::SlidingWindowWidth(length);
+      Representation oddPowers[TableSize];
+      oddPowers[0] = representation();
+      if (width > 1) {
+        auto const square = Arithmetic::Square(representation());
+        for (std::size_t idx = 1; idx < (std::size_t(1) << (width - 1)); ++idx)
+          oddPowers[idx] = Arithmetic::Multiply(oddPowers[idx - 1], square);
+      }
+
+      // The top bit is set, so the first window initialises the result.
+      auto low = length - width > 0 ? length - width : 0;
+      while (!bits.test(low))
+        ++low;
+      auto result = oddPowers[bits.window(length - 1, low) >> 1];
+
+      for (auto high = low - 1; high >= 0;) {
+        if (!bits.test(high)) {
+          result = Arithmetic::Square(result);
+          --high;
+          continue;
+        }
+
+        low = high - width + 1 > 0 ? high - width + 1 : 0;
+        while (!bits.test(low))
+          ++low;
+        for (auto bit = high; bit >= low; --bit)
+          result = Arithmetic::Square(result);
+        result = Arithmetic::Multiply(
+            result, oddPowers[bits.window(high, low) >> 1]);
+        high = low - 1;
+      }
+      return {FromRepresentation{}, result};
+    }
   };
+
+
+  // Inverts every element of [first, last) in place with Montgomery's
+  // trick: a single inversion of the product of all elements, from which
+  // the prefix products peel off the individual inverses, 3 (n - 1)
+  // multiplications in all. Like inverse() it throws if any element isn't
+  // invertible.
+  template <typename BidirectionalIt>
+  void BatchInverse(BidirectionalIt first, BidirectionalIt last) {
+    using Ring = typename std::iterator_traits<BidirectionalIt>::value_type;
+    if (first == last)
+      return;
+
+    std::vector<Ring> prefixes;
+    prefixes.reserve(std::size_t(std::distance(first, last)));
+    prefixes.push_back(*first);
+    for (auto it = std::next(first); it != last; ++it)
+      prefixes.push_back(prefixes.back() * *it);
+
+    // Walking backwards, inverse is that of the product up to `it`.
+    auto inverse = prefixes.back().inverse();
+    auto it = last;
+    for (auto idx = prefixes.size() - 1; idx > 0; --idx) {
+      --it;
+      auto const element = *it;
+      *it = inverse * prefixes[idx - 1];
+      inverse = inverse * element;
+    }
+    *first = inverse;
+  }
 } // namespace CryptoCom
 
 
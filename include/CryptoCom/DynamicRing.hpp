@@ -0,0 +1,428 @@
+#pragma once
+
+#include <CryptoCom/Barrett.hpp>
+#include <CryptoCom/FixedBase.hpp>
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/LimbArithmetic.hpp>
+#include <CryptoCom/Montgomery.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+
+namespace CryptoCom {
+
+  template <typename RingTraits>
+  class CyclicRing;
+
+  template <typename RingTraits>
+  class DynamicRingContext;
+
+
+  // Traits of a ring whose order and generator are chosen at run time, for
+  // instance loaded from configuration, rather than compiled in. A group is
+  // declared once as
+  //
+  //   struct Group : DynamicRingTraits<Group, int64_t, UInt128, int64_t> {};
+  //
+  // and its parameters are installed with DynamicRingContext<Group>. Order
+  // and Generator refer to the installed ones, so DynamicCyclicRing<Group>
+  // fits everywhere a CyclicRing does.
+  template <typename Group, typename Primary, typename Escalation,
+      typename Coefficient>
+  struct DynamicRingTraits {
+    using PrimaryType = Primary;
+    using EscalationType = Escalation;
+    using CoefficientType = Coefficient;
+    using Reduction = DynamicReduction;
+
+    static PrimaryType const& Order;
+    static PrimaryType const& Generator;
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  template <typename Group, typename Primary, typename Escalation,
+      typename Coefficient>
+  Primary const&
+      DynamicRingTraits<Group, Primary, Escalation, Coefficient>::Order =
+          DynamicRingContext<Group>::installedOrder_;
+
+  template <typename Group, typename Primary, typename Escalation,
+      typename Coefficient>
+  Primary const&
+      DynamicRingTraits<Group, Primary, Escalation, Coefficient>::Generator =
+          DynamicRingContext<Group>::installedGenerator_;
+
+  template <typename Group, typename Primary, typename Escalation,
+      typename Coefficient>
+  constexpr Primary DynamicRingTraits<Group, Primary, Escalation,
+      Coefficient>::AdditiveIdentity;
+
+  template <typename Group, typename Primary, typename Escalation,
+      typename Coefficient>
+  constexpr Primary DynamicRingTraits<Group, Primary, Escalation,
+      Coefficient>::MultiplicativeIdentity;
+
+
+  template <typename RingTraits>
+  using DynamicCyclicRing = CyclicRing<RingTraits>;
+
+
+  namespace detail {
+
+    // Run time counterpart of the Montgomery and Barrett kernels for word
+    // sized orders. Odd orders are kept in Montgomery form, even ones are
+    // reduced with the Barrett reciprocal, a division by a constant the way
+    // libdivide does it. Either way the constants are computed once per
+    // context and a product costs the same multiplications as in the
+    // compile time kernels, plus loading the constants and a branch which
+    // always goes the same way.
+    template <typename RingTraits>
+    struct DynamicWordReduction {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using EscalationType = typename RingTraits::EscalationType;
+      using Representation = PrimaryType;
+
+      using Word = typename UnsignedOf<PrimaryType>::type;
+      using DoubleWord = typename UnsignedOf<EscalationType>::type;
+
+      static_assert(Digits<DoubleWord>::value >= 2 * Digits<Word>::value,
+          "run time orders need an EscalationType twice as wide as the "
+          "PrimaryType");
+
+
+      struct Constants {
+        Word order = 0;
+        bool montgomery = false;
+        Word negInverse = 0;
+        Word rSquared = 0;
+        int orderBits = 0;
+        Word reciprocal = 0;
+
+        explicit Constants(PrimaryType const value) {
+          if (value < 2 || Word(value) - 1 > MaxOf<Word>() / 2) {
+            throw std::invalid_argument(
+                "the order has to be at least two and the sum of two "
+                "residues has to fit into the PrimaryType");
+          }
+
+          order = Word(value);
+          montgomery = order % 2 == 1;
+          if (montgomery) {
+            negInverse = MontgomeryNegInverse(order);
+            rSquared = MontgomeryRSquared<Word, DoubleWord>(order);
+            return;
+          }
+
+          orderBits = BitLength(order);
+          if (2 * orderBits >= Digits<DoubleWord>::value ||
+              (DoubleWord(1) << (2 * orderBits)) / order > MaxOf<Word>()) {
+            throw std::invalid_argument(
+                "the Barrett reciprocal of the order has to fit into a word");
+          }
+          reciprocal = Word((DoubleWord(1) << (2 * orderBits)) / order);
+        }
+      };
+
+      static Constants const& Context() {
+        return DynamicRingContext<RingTraits>::Current().constants();
+      }
+
+
+      static Word Reduce(Constants const& c, DoubleWord const value) {
+        return c.montgomery
+                   ? MontgomeryRedc(value, c.order, c.negInverse)
+                   : BarrettReduce(value, c.order, c.orderBits, c.reciprocal);
+      }
+
+      static Representation FromInteger(PrimaryType const value) {
+        auto const& c = Context();
+        auto const order = PrimaryType(c.order);
+        auto const remainder = PrimaryType(value % order);
+        auto const canonical =
+            remainder < 0 ? PrimaryType(remainder + order) : remainder;
+        if (!c.montgomery)
+          return canonical;
+        return Representation(
+            Reduce(c, DoubleWord(Word(canonical)) * c.rSquared));
+      }
+
+      static PrimaryType ToInteger(Representation const value) {
+        auto const& c = Context();
+        if (!c.montgomery)
+          return value;
+        return PrimaryType(Reduce(c, DoubleWord(Word(value))));
+      }
+
+      static Representation Add(
+          Representation const lhs, Representation const rhs) {
+        auto const order = Context().order;
+        auto const sum = Word(Word(lhs) + Word(rhs));
+        return Representation(sum >= order ? Word(sum - order) : sum);
+      }
+
+      static Representation Subtract(
+          Representation const lhs, Representation const rhs) {
+        auto const order = Context().order;
+        return Representation(lhs >= rhs
+                                  ? Word(Word(lhs) - Word(rhs))
+                                  : Word(Word(lhs) + (order - Word(rhs))));
+      }
+
+      static Representation Negate(Representation const value) {
+        return value == 0
+                   ? value
+                   : Representation(Word(Context().order - Word(value)));
+      }
+
+      static bool Equal(Representation const lhs, Representation const rhs) {
+        return lhs == rhs;
+      }
+
+      static bool Less(Representation const lhs, Representation const rhs) {
+        return lhs < rhs;
+      }
+
+      static Representation Multiply(
+          Representation const lhs, Representation const rhs) {
+        return Representation(
+            Reduce(Context(), DoubleWord(Word(lhs)) * Word(rhs)));
+      }
+
+      static Representation Square(Representation const value) {
+        return Multiply(value, value);
+      }
+    };
+
+
+    // Run time counterpart of LimbMontgomery, for odd FixedUInt orders.
+    template <typename RingTraits>
+    struct DynamicLimbReduction {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using Representation = PrimaryType;
+      using Limb = typename PrimaryType::Limb;
+      static constexpr std::size_t LimbCount = PrimaryType::LimbCount;
+
+
+      struct Constants {
+        PrimaryType order;
+        Limb negInverse = 0;
+        PrimaryType rSquared;
+
+        explicit Constants(PrimaryType const& value) {
+          if (value < 2 || (value.data()[0] & 1) == 0 ||
+              value - 1 > MaxOf<PrimaryType>() / 2) {
+            throw std::invalid_argument(
+                "run time FixedUInt orders have to be odd and the sum of two "
+                "residues has to fit into the PrimaryType");
+          }
+
+          order = value;
+          negInverse = MontgomeryNegInverse(value.data()[0]);
+          rSquared = LimbMontgomeryRSquared(value);
+        }
+      };
+
+      static Constants const& Context() {
+        return DynamicRingContext<RingTraits>::Current().constants();
+      }
+
+
+      static Representation FromInteger(PrimaryType const& value) {
+        auto const& c = Context();
+        Limb product[2 * LimbCount];
+        LimbProduct<LimbCount>::Multiply(
+            PrimaryType(value % c.order).data(), c.rSquared.data(), product);
+        return LimbMontgomeryReduce(product, c.order, c.negInverse);
+      }
+
+      static PrimaryType ToInteger(Representation const& value) {
+        auto const& c = Context();
+        Limb product[2 * LimbCount] = {};
+        for (std::size_t j = 0; j < LimbCount; ++j)
+          product[j] = value.data()[j];
+        return LimbMontgomeryReduce(product, c.order, c.negInverse);
+      }
+
+      static Representation Add(
+          Representation const& lhs, Representation const& rhs) {
+        auto const& order = Context().order;
+        auto sum = lhs + rhs;
+        if (sum >= order)
+          sum -= order;
+        return sum;
+      }
+
+      static Representation Subtract(
+          Representation const& lhs, Representation const& rhs) {
+        return lhs >= rhs ? Representation(lhs - rhs)
+                          : Representation(lhs + (Context().order - rhs));
+      }
+
+      static Representation Negate(Representation const& value) {
+        return value == 0 ? value : Representation(Context().order - value);
+      }
+
+      static bool Equal(Representation const& lhs, Representation const& rhs) {
+        return lhs == rhs;
+      }
+
+      static bool Less(Representation const& lhs, Representation const& rhs) {
+        return lhs < rhs;
+      }
+
+      static Representation Multiply(
+          Representation const& lhs, Representation const& rhs) {
+        auto const& c = Context();
+        Limb product[2 * LimbCount];
+        LimbProduct<LimbCount>::Multiply(lhs.data(), rhs.data(), product);
+        return LimbMontgomeryReduce(product, c.order, c.negInverse);
+      }
+
+      static Representation Square(Representation const& value) {
+        auto const& c = Context();
+        Limb product[2 * LimbCount];
+        LimbSquare<LimbCount>::Square(value.data(), product);
+        return LimbMontgomeryReduce(product, c.order, c.negInverse);
+      }
+    };
+
+
+    // A run time order may be anything up to the width of the PrimaryType.
+    template <typename RingTraits>
+    struct OrderBits<RingTraits, DynamicReduction>
+        : Digits<typename UnsignedOf<typename RingTraits::PrimaryType>::type> {
+    };
+
+
+    template <typename RingTraits>
+    struct DynamicGeneratorPowers {
+      using Table = typename DynamicRingContext<RingTraits>::GeneratorTable;
+
+      static Table const& Get() {
+        return DynamicRingContext<RingTraits>::Current().generatorPowers();
+      }
+    };
+
+    template <typename RingTraits>
+    struct GeneratorPowers<RingTraits, false, DynamicReduction>
+        : DynamicGeneratorPowers<RingTraits> {};
+
+    template <typename RingTraits>
+    struct GeneratorPowers<RingTraits, true, DynamicReduction>
+        : DynamicGeneratorPowers<RingTraits> {};
+
+
+    // Run time orders are checked against the StorageType as they are
+    // installed.
+    template <typename RingTraits, typename StorageType>
+    struct StorageHoldsOrder<RingTraits, StorageType, DynamicReduction>
+        : std::true_type {};
+
+  } // namespace detail
+
+
+  template <typename RingTraits>
+  struct ReductionKernel<DynamicReduction, RingTraits>
+      : public std::conditional<
+            detail::IsFixedInteger<typename RingTraits::PrimaryType>::value,
+            detail::DynamicLimbReduction<RingTraits>,
+            detail::DynamicWordReduction<RingTraits>>::type {};
+
+
+  // The parameters of a run time group, shared by all of its elements: the
+  // order and generator along with the reduction constants and the fixed
+  // base table of the generator derived from them. Exactly one context per
+  // group is installed at any time and elements are only meaningful under
+  // the context they were created in, so contexts are meant to be installed
+  // at startup, or switched between phases which don't share elements.
+  template <typename RingTraits>
+  class DynamicRingContext {
+  public:
+    using PrimaryType = typename RingTraits::PrimaryType;
+    using Arithmetic = ReductionKernel<DynamicReduction, RingTraits>;
+    using Constants = typename Arithmetic::Constants;
+    using GeneratorTable = detail::FixedBaseTable<Arithmetic,
+        detail::FixedBaseWidth, detail::OrderBits<RingTraits>::value>;
+
+    // Derives the constants of a group and installs it. Throws
+    // std::invalid_argument for orders the kernel can't reduce modulo or
+    // whose residues don't fit into the group's StorageType.
+    static std::shared_ptr<DynamicRingContext const> Install(
+        PrimaryType const& order, PrimaryType const& generator) {
+      using Storage = typename detail::StorageOf<RingTraits,
+          typename Arithmetic::Representation>::type;
+      if (!detail::StorageHolds<Storage>(order)) {
+        throw std::invalid_argument(
+            "the residues of the order have to fit into the StorageType");
+      }
+      std::shared_ptr<DynamicRingContext> context{
+          new DynamicRingContext(order, generator)};
+      Install(context);
+      context->generatorPowers_ = std::make_shared<GeneratorTable const>(
+          Arithmetic::FromInteger(generator));
+      return context;
+    }
+
+    // Switches back to a previously installed group.
+    static void Install(std::shared_ptr<DynamicRingContext const> context) {
+      current_ = context.get();
+      installedOrder_ = context->order_;
+      installedGenerator_ = context->generator_;
+      Installed() = std::move(context);
+    }
+
+    // The installed context. Throws std::logic_error before the first
+    // Install, which elements built by the noexcept constructors turn into
+    // std::terminate rather than reading through a null context.
+    static DynamicRingContext const& Current() {
+      if (current_ == nullptr)
+        throw std::logic_error("no DynamicRingContext installed");
+      return *current_;
+    }
+
+    PrimaryType const& order() const { return order_; }
+    PrimaryType const& generator() const { return generator_; }
+    Constants const& constants() const { return constants_; }
+    GeneratorTable const& generatorPowers() const { return *generatorPowers_; }
+
+  private:
+    template <typename, typename, typename, typename>
+    friend struct DynamicRingTraits;
+
+    DynamicRingContext(PrimaryType const& order, PrimaryType const& generator)
+        : order_(order)
+        , generator_(generator)
+        , constants_(order) {}
+
+    static std::shared_ptr<DynamicRingContext const>& Installed() {
+      static std::shared_ptr<DynamicRingContext const> installed;
+      return installed;
+    }
+
+    PrimaryType order_;
+    PrimaryType generator_;
+    Constants constants_;
+    std::shared_ptr<GeneratorTable const> generatorPowers_;
+
+    static DynamicRingContext const* current_;
+    static PrimaryType installedOrder_;
+    static PrimaryType installedGenerator_;
+  };
+
+  template <typename RingTraits>
+  DynamicRingContext<RingTraits> const*
+      DynamicRingContext<RingTraits>::current_ = nullptr;
+
+  template <typename RingTraits>
+  typename RingTraits::PrimaryType
+      DynamicRingContext<RingTraits>::installedOrder_{};
+
+  template <typename RingTraits>
+  typename RingTraits::PrimaryType
+      DynamicRingContext<RingTraits>::installedGenerator_{};
+
+} // namespace CryptoCom
@@ -1,27 +1,58 @@
 #pragma once
 
+#include <CryptoCom/BatchPow.hpp>
 #include <CryptoCom/CyclicRing.hpp>
 #include <array>
 #include <functional>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 namespace CryptoCom {
 
+  // A public key prepared for encrypting many messages: the key ^ random
+  // term of every encryption is looked up in a fixed-base table built once
+  // for the key. Width is the digit width of the table, wider digits need
+  // fewer multiplications per encryption and exponentially more memory.
+  template <typename RingTraits, int Width = detail::FixedBaseWidth>
+  class PreparedPublicKey {
+    using Ring = CyclicRing<RingTraits>;
+    typename Ring::template FixedBase<Width> powers_;
+
+  public:
+    explicit PreparedPublicKey(Ring const& key) : powers_(key) {}
+
+    Ring const& key() const { return powers_.base(); }
+
+    Ring pow(Ring const& exponent) const { return powers_.pow(exponent); }
+  };
+
+
   template <typename RingTraits>
   struct ElGamal {
     using Ring = CyclicRing<RingTraits>;
     using RNG = std::function<Ring()>;
     using Cipher = std::array<Ring, 2>;
 
+    // The secret is drawn as a ring element and kept as the exponent it
+    // stands for, which in a Schnorr group is below the subgroup order.
     static auto KeyPairOf(RNG rng) {
-      auto const secret = rng();
-      return std::make_tuple(secret, Ring::Generator() ^ secret);
+      auto const secret = Ring{rng().exponent()};
+      return std::make_tuple(secret, Ring::GeneratorPow(secret));
     }
 
 
     static Cipher Encrypt(Ring const& key, Ring const& plainText, RNG rng) {
       auto const random = rng();
-      return {{Ring::Generator() ^ random, (key ^ random) * plainText}};
+      return {{Ring::GeneratorPow(random), (key ^ random) * plainText}};
+    }
+
+
+    template <int Width>
+    static Cipher Encrypt(PreparedPublicKey<RingTraits, Width> const& key,
+        Ring const& plainText, RNG rng) {
+      auto const random = rng();
+      return {{Ring::GeneratorPow(random), key.pow(random) * plainText}};
     }
 
 
@@ -29,6 +60,49 @@ namespace CryptoCom {
       auto const sharedSecret = encryptedMessage[0] ^ key;
       return encryptedMessage[1] / sharedSecret;
     }
+
+
+    // Encrypts the plain texts of [first, last), drawing the random terms
+    // in the order the same calls of Encrypt would. Every key ^ random term
+    // shares the one base, so they are looked up in a fixed-base table of
+    // the key built once for the batch rather than raised with BatchPow,
+    // which would build a window table per lane for copies of the key.
+    template <typename InputIt>
+    static std::vector<Cipher> EncryptBatch(
+        Ring const& key, InputIt first, InputIt last, RNG rng) {
+      return EncryptBatch(PreparedPublicKey<RingTraits>{key}, first, last,
+          std::move(rng));
+    }
+
+
+    template <int Width, typename InputIt>
+    static std::vector<Cipher> EncryptBatch(
+        PreparedPublicKey<RingTraits, Width> const& key, InputIt first,
+        InputIt last, RNG rng) {
+      std::vector<Cipher> ciphers;
+      for (auto it = first; it != last; ++it)
+        ciphers.push_back(Encrypt(key, *it, rng));
+      return ciphers;
+    }
+
+
+    // Decrypts the ciphers of [first, last) with the shared secrets raised
+    // side by side and a single inversion for all of them.
+    template <typename InputIt>
+    static std::vector<Ring> DecryptBatch(
+        Ring const& key, InputIt first, InputIt last) {
+      std::vector<Ring> plainTexts;
+      for (auto it = first; it != last; ++it)
+        plainTexts.push_back((*it)[0]);
+      std::vector<Ring> const keys(plainTexts.size(), key);
+      plainTexts = BatchPow(plainTexts, keys);
+      BatchInverse(plainTexts.begin(), plainTexts.end());
+
+      auto plainText = plainTexts.begin();
+      for (auto it = first; it != last; ++it, ++plainText)
+        *plainText = (*it)[1] * *plainText;
+      return plainTexts;
+    }
   };
 
 } // namespace CryptoCom
@@ -1,35 +1,217 @@
 #pragma once
 
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
 #include <cmath>
+#include <cstdint>
 #include <stdexcept>
 #include <tuple>
+#include <utility>
 
 namespace CryptoCom {
 
+  namespace detail {
+
+    // g = a x + b y iteratively, with one division per step.
+    template <typename T, typename CoefficientType>
+    std::tuple<T, CoefficientType, CoefficientType> EuclideanGCD(T a, T b) {
+      CoefficientType x0 = 1, x1 = 0, y0 = 0, y1 = 1;
+      while (b != 0) {
+        auto const q = T(a / b);
+        auto const r = T(a - q * b);
+        a = b;
+        b = r;
+
+        auto const x = CoefficientType(x0 - CoefficientType(q) * x1);
+        x0 = x1;
+        x1 = x;
+        auto const y = CoefficientType(y0 - CoefficientType(q) * y1);
+        y0 = y1;
+        y1 = y;
+      }
+      return std::make_tuple(a, x0, y0);
+    }
+
+
+    template <std::size_t Bits, bool Signed>
+    int SignificantBits(FixedInteger<Bits, Signed> const& value) {
+      for (auto idx = FixedInteger<Bits, Signed>::LimbCount; idx > 0; --idx) {
+        if (value.data()[idx - 1] != 0)
+          return int(64 * (idx - 1)) + BitLength(value.data()[idx - 1]);
+      }
+      return 0;
+    }
+
+
+    // Lehmer's algorithm (Knuth, Algorithm 4.5.2L) for multi-precision
+    // integers. The quotients of a run of Euclidean steps are found from
+    // the leading 62 bits of both operands alone, in single precision, as
+    // long as both bounds of the quotient agree. The run is then applied to
+    // the full operands and cofactors at once as a 2 by 2 matrix, which
+    // replaces a multi-precision division per step by a few word by
+    // multi-precision multiplications per run. Intermediate results are
+    // exact modulo 2^Bits, so the wrapping FixedInteger arithmetic is
+    // correct even where the matrix has negative entries.
+    template <typename T, typename CoefficientType>
+    std::tuple<T, CoefficientType, CoefficientType> LehmerGCD(T a, T b) {
+      constexpr int LeadingBits = 62;
+
+      T u = a, v = b;
+      CoefficientType x0 = 1, x1 = 0, y0 = 0, y1 = 1;
+      if (u < v) {
+        std::swap(u, v);
+        std::swap(x0, x1);
+        std::swap(y0, y1);
+      }
+
+      while (v != 0) {
+        auto const bits = SignificantBits(u);
+        auto const shift = bits > LeadingBits ? bits - LeadingBits : 0;
+        auto uHat = std::int64_t((u >> shift).data()[0]);
+        auto vHat = std::int64_t((v >> shift).data()[0]);
+
+        std::int64_t A = 1, B = 0, C = 0, D = 1;
+        while (vHat + C != 0 && vHat + D != 0) {
+          auto const q = (uHat + A) / (vHat + C);
+          if (q != (uHat + B) / (vHat + D))
+            break;
+
+          auto t = A - q * C;
+          A = C;
+          C = t;
+          t = B - q * D;
+          B = D;
+          D = t;
+          t = uHat - q * vHat;
+          uHat = vHat;
+          vHat = t;
+        }
+
+        if (B == 0) {
+          auto const q = u / v;
+          auto const r = T(u - q * v);
+          u = v;
+          v = r;
+
+          auto const x = CoefficientType(x0 - CoefficientType(q) * x1);
+          x0 = x1;
+          x1 = x;
+          auto const y = CoefficientType(y0 - CoefficientType(q) * y1);
+          y0 = y1;
+          y1 = y;
+          continue;
+        }
+
+        auto const nextU = T(T(A) * u + T(B) * v);
+        v = T(T(C) * u + T(D) * v);
+        u = nextU;
+
+        auto const nextX0 = CoefficientType(
+            CoefficientType(A) * x0 + CoefficientType(B) * x1);
+        x1 = CoefficientType(CoefficientType(C) * x0 + CoefficientType(D) * x1);
+        x0 = nextX0;
+        auto const nextY0 = CoefficientType(
+            CoefficientType(A) * y0 + CoefficientType(B) * y1);
+        y1 = CoefficientType(CoefficientType(C) * y0 + CoefficientType(D) * y1);
+        y0 = nextY0;
+      }
+      return std::make_tuple(u, x0, y0);
+    }
+
+
+    // Inverse modulo an odd modulus by the binary algorithm (Stein): only
+    // shifts, subtractions and comparisons, no division at all. The loop
+    // keeps x1 a = u and x2 a = v modulo the modulus.
+    template <typename T>
+    T BinaryInverseModulo(T const a, T const modulus) {
+      using Unsigned = typename UnsignedOf<T>::type;
+      auto const m = Unsigned(modulus);
+      // (x + m) / 2 for odd x without overflowing.
+      auto const halve = [m](Unsigned const x) {
+        return x % 2 == 0 ? Unsigned(x / 2) : Unsigned(x / 2 + m / 2 + 1);
+      };
+
+      Unsigned u = Unsigned(a) % m, v = m, x1 = 1, x2 = 0;
+      while (u != 1 && v != 1) {
+        if (u == 0)
+          throw std::invalid_argument("relative primes have no inverse modulo");
+
+        for (; u % 2 == 0; u /= 2)
+          x1 = halve(x1);
+        for (; v % 2 == 0; v /= 2)
+          x2 = halve(x2);
+
+        if (u >= v) {
+          u -= v;
+          x1 = x1 >= x2 ? Unsigned(x1 - x2) : Unsigned(x1 + (m - x2));
+        } else {
+          v -= u;
+          x2 = x2 >= x1 ? Unsigned(x2 - x1) : Unsigned(x2 + (m - x1));
+        }
+      }
+      return T(u == 1 ? x1 : x2);
+    }
+
+
+    template <typename T, typename CoefficientType>
+    T InverseFromGCD(std::tuple<T, CoefficientType, CoefficientType> const&
+                         gcd,
+        T const b) {
+      T g;
+      CoefficientType x;
+      std::tie(g, x, std::ignore) = gcd;
+
+      if (g == 1) {
+        return x < 0 ? T(b + x) : T(x) % b;
+      }
+
+      throw std::invalid_argument("relative primes have no inverse modulo");
+    }
+
+
+    template <typename T, typename CoefficientType>
+    std::tuple<T, CoefficientType, CoefficientType> ExtendedGCD(
+        T const a, T const b, std::true_type /* multi-precision */) {
+      return LehmerGCD<T, CoefficientType>(a, b);
+    }
+
+    template <typename T, typename CoefficientType>
+    std::tuple<T, CoefficientType, CoefficientType> ExtendedGCD(
+        T const a, T const b, std::false_type /* multi-precision */) {
+      return EuclideanGCD<T, CoefficientType>(a, b);
+    }
+
+
+    template <typename T, typename CoefficientType>
+    T InverseModulo(
+        T const a, T const b, std::true_type /* multi-precision */) {
+      return InverseFromGCD(LehmerGCD<T, CoefficientType>(a, b), b);
+    }
+
+    template <typename T, typename CoefficientType>
+    T InverseModulo(
+        T const a, T const b, std::false_type /* multi-precision */) {
+      if (b % 2 == 1)
+        return BinaryInverseModulo(a, b);
+      return InverseFromGCD(EuclideanGCD<T, CoefficientType>(a, b), b);
+    }
+
+  } // namespace detail
+
+
+  // g = gcd(a, b) along with the Bezout coefficients g = a x + b y, by
+  // Lehmer's algorithm for FixedInteger and Euclid's for word sized types.
   template <typename T, typename CoefficientType>
   std::tuple<T, CoefficientType, CoefficientType> ExtendedGCD(T a, T b) {
-    if (a == 0)
-      return std::make_tuple(b, 0, 1);
-
-    T g;
-    CoefficientType x, y;
-    std::tie(g, x, y) = ExtendedGCD<T, CoefficientType>(b % a, a);
-    auto const s = y - (CoefficientType(b) / CoefficientType(a)) * x;
-    return std::make_tuple(g, s, x);
+    return detail::ExtendedGCD<T, CoefficientType>(
+        a, b, detail::IsFixedInteger<T>{});
   }
 
 
   template <typename T, typename CoefficientType>
   T InverseModulo(T const a, T const b) {
-    T g;
-    CoefficientType x;
-    std::tie(g, x, std::ignore) = ExtendedGCD<T, CoefficientType>(a, b);
-
-    if (g == 1) {
-      return x < 0 ? T(b + x) : T(x) % b;
-    }
-
-    throw std::invalid_argument("relative primes have no inverse modulo");
+    return detail::InverseModulo<T, CoefficientType>(
+        a, b, detail::IsFixedInteger<T>{});
   }
 
 } // namespace CryptoCom
@@ -0,0 +1,174 @@
+#pragma once
+
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace CryptoCom {
+  namespace detail {
+
+    template <std::size_t Bits, bool Signed>
+    void LoadExponentWords(FixedInteger<Bits, Signed> const& value,
+        std::uint64_t* words, std::size_t const count) {
+      for (std::size_t idx = 0; idx < count; ++idx)
+        words[idx] = value.data()[idx];
+    }
+
+    template <typename IntegralType>
+    void LoadExponentWords(IntegralType const value, std::uint64_t* words,
+        std::size_t const count) {
+      for (std::size_t idx = 0; idx < count; ++idx)
+        words[idx] = std::uint64_t(UInt128(value) >> (64 * idx));
+    }
+
+
+    // The bits of a non-negative exponent of any integer type, built-in or
+    // FixedInteger, copied into 64 bit words for random access.
+    template <typename IntegralType>
+    class ExponentBits {
+    public:
+      static constexpr std::size_t WordCount =
+          (Digits<IntegralType>::value + 63) / 64;
+      static constexpr int MaxLength = int(64 * WordCount);
+
+      explicit ExponentBits(IntegralType const& exponent) {
+        LoadExponentWords(exponent, words_, WordCount);
+      }
+
+      // The number of significant bits, zero for a zero exponent.
+      int length() const {
+        for (auto idx = WordCount; idx > 0; --idx) {
+          if (words_[idx - 1] != 0)
+            return int(64 * idx) - __builtin_clzll(words_[idx - 1]);
+        }
+        return 0;
+      }
+
+      bool test(int const bit) const {
+        return (words_[bit / 64] >> (bit % 64)) & 1;
+      }
+
+      // The bits [low, high] as an integer, at most 32 of them.
+      std::uint32_t window(int const high, int const low) const {
+        if (high / 64 == low / 64) {
+          auto const width = high - low + 1;
+          return std::uint32_t((words_[low / 64] >> (low % 64)) &
+                               ((std::uint64_t(1) << width) - 1));
+        }
+        std::uint32_t result = 0;
+        for (int bit = high; bit >= low; --bit)
+          result = (result << 1) | std::uint32_t(test(bit));
+        return result;
+      }
+
+    private:
+      std::uint64_t words_[WordCount];
+    };
+
+
+    // Window width of sliding window exponentiation for exponents of the
+    // given bit length. A w bit window costs 2^(w-1) multiplications for
+    // the table of odd powers and saves multiplications on every window of
+    // the exponent, the thresholds are where the wider window breaks even.
+    constexpr int SlidingWindowWidth(int const bits) {
+      return bits > 671   ? 6
+             : bits > 239 ? 5
+             : bits > 79  ? 4
+             : bits > 23  ? 3
+             : bits > 6   ? 2
+                          : 1;
+    }
+
+
+    constexpr bool TestBit(std::uint64_t const value, int const bit) {
+      return (value >> bit) & 1;
+    }
+
+    constexpr std::uint64_t BitWindow(
+        std::uint64_t const value, int const high, int const low) {
+      return (value >> low) & ((std::uint64_t(2) << (high - low)) - 1);
+    }
+
+
+    // An addition chain for an exponent known at compile time, in the
+    // shape of a sliding window exponentiation: the odd powers x, x^3, ...
+    // of the base it uses, then, starting from the odd power `first`, one
+    // step per squaring (-1) or multiplication by the k-th odd power (k).
+    struct AdditionChainSteps {
+      static constexpr int MaxSteps = 128;
+
+      int oddPowers = 0;
+      int first = 0;
+      int count = 0;
+      int steps[MaxSteps] = {};
+
+      // Multiplications and squarings, those of the odd powers included.
+      constexpr int cost() const {
+        return (oddPowers > 1 ? oddPowers : 0) + count;
+      }
+    };
+
+
+    constexpr AdditionChainSteps SlidingWindowChain(
+        std::uint64_t const exponent, int const width) {
+      AdditionChainSteps chain;
+      auto const length = BitLength(exponent);
+      if (length == 0)
+        return chain;
+
+      auto low = length - width > 0 ? length - width : 0;
+      while (!TestBit(exponent, low))
+        ++low;
+      chain.first = int(BitWindow(exponent, length - 1, low) >> 1);
+      auto largest = chain.first;
+
+      for (auto high = low - 1; high >= 0;) {
+        if (!TestBit(exponent, high)) {
+          chain.steps[chain.count++] = -1;
+          --high;
+          continue;
+        }
+
+        low = high - width + 1 > 0 ? high - width + 1 : 0;
+        while (!TestBit(exponent, low))
+          ++low;
+        for (auto bit = high; bit >= low; --bit)
+          chain.steps[chain.count++] = -1;
+        auto const power = int(BitWindow(exponent, high, low) >> 1);
+        chain.steps[chain.count++] = power;
+        largest = power > largest ? power : largest;
+        high = low - 1;
+      }
+      chain.oddPowers = largest + 1;
+      return chain;
+    }
+
+
+    // The cheapest of the sliding window chains over every window width.
+    // Unlike at run time, the table only holds the odd powers the exponent
+    // actually needs, so wider windows pay off earlier.
+    constexpr AdditionChainSteps ShortestAdditionChain(
+        std::uint64_t const exponent) {
+      auto best = SlidingWindowChain(exponent, 1);
+      for (int width = 2; width <= 6; ++width) {
+        auto const chain = SlidingWindowChain(exponent, width);
+        if (chain.cost() < best.cost())
+          best = chain;
+      }
+      return best;
+    }
+
+
+    template <std::uint64_t Exponent>
+    struct AdditionChain {
+      static constexpr AdditionChainSteps Value =
+          ShortestAdditionChain(Exponent);
+    };
+
+    template <std::uint64_t Exponent>
+    constexpr AdditionChainSteps AdditionChain<Exponent>::Value;
+
+  } // namespace detail
+} // namespace CryptoCom
@@ -6,6 +6,7 @@
 #include <functional>
 #include <stdexcept>
 #include <tuple>
+#include <vector>
 
 namespace CryptoCom {
 
@@ -27,13 +28,23 @@ namespace CryptoCom {
           throw std::out_of_range("ElGamal cipher can't contain 0");
       }
 
+      // The encryption of 0 without any randomness, which adding to a
+      // cipher leaves it unchanged.
+      static Cipher Zero() { return {Ring::One(), Ring::One()}; }
+
       Cipher operator+(Cipher const& other) const {
         return {components[0] * other.components[0],
             components[1] * other.components[1]};
       }
 
+      // The encryption of the difference of the plain texts.
+      Cipher operator-(Cipher const& other) const {
+        return {components[0] / other.components[0],
+            components[1] / other.components[1]};
+      }
+
       Cipher operator+(Ring const& other) const {
-        return {components[0], components[1] * (Ring::Generator() ^ other)};
+        return {components[0], components[1] * Ring::GeneratorPow(other)};
       }
 
       Cipher operator*(Ring const& other) const {
@@ -52,7 +63,7 @@ namespace CryptoCom {
     };
 
 
-    static Ring Decipher(Ring const& e) { return Ring::Generator() ^ e; }
+    static Ring Decipher(Ring const& e) { return Ring::GeneratorPow(e); }
 
 
     static std::tuple<Ring, Ring> KeyPairOf(RNG rng) {
@@ -63,13 +74,44 @@ namespace CryptoCom {
     template <typename IntegralType>
     static Cipher Encrypt(Ring const& key, IntegralType plainText, RNG rng) {
       return ElGamal<RingTraits>::Encrypt(
-          key, Ring::Generator() ^ plainText, rng);
+          key, Ring::GeneratorPow(plainText), rng);
+    }
+
+
+    template <int Width, typename IntegralType>
+    static Cipher Encrypt(PreparedPublicKey<RingTraits, Width> const& key,
+        IntegralType plainText, RNG rng) {
+      return ElGamal<RingTraits>::Encrypt(
+          key, Ring::GeneratorPow(plainText), rng);
+    }
+
+
+    // The key is a Ring or a PreparedPublicKey, as for Encrypt.
+    template <typename Key, typename InputIt>
+    static std::vector<Cipher> EncryptBatch(
+        Key const& key, InputIt first, InputIt last, RNG rng) {
+      std::vector<Ring> messages;
+      for (auto it = first; it != last; ++it)
+        messages.push_back(Ring::GeneratorPow(*it));
+      auto const ciphers =
+          Base::EncryptBatch(key, messages.cbegin(), messages.cend(), rng);
+      return {ciphers.cbegin(), ciphers.cend()};
     }
 
 
     static Ring Decrypt(Ring const& key, Cipher const& encryptedMessage) {
       return ElGamal<RingTraits>::Decrypt(key, encryptedMessage.components);
     }
+
+
+    template <typename InputIt>
+    static std::vector<Ring> DecryptBatch(
+        Ring const& key, InputIt first, InputIt last) {
+      std::vector<typename Base::Cipher> components;
+      for (auto it = first; it != last; ++it)
+        components.push_back(it->components);
+      return Base::DecryptBatch(key, components.cbegin(), components.cend());
+    }
   };
 
 } // namespace CryptoCom
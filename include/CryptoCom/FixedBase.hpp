@@ -0,0 +1,122 @@
+#pragma once
+
+#include <CryptoCom/Exponent.hpp>
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace CryptoCom {
+  namespace detail {
+
+    // Digit width of the generator tables: 2^w - 1 powers per window.
+    constexpr int FixedBaseWidth = 4;
+
+
+    // Fixed-base windowing (Yao; Brickell, Gordon, McCurley and Wilson).
+    // With b_k = base^(2^(w k)) and its powers b_k^d precomputed for every
+    // w bit digit d of every window k, base^e is the product of one table
+    // entry per nonzero digit of e, without any squaring. This pays off
+    // for short exponents as much as for full width ones.
+    template <typename Arithmetic, int Width, int Bits>
+    class FixedBaseTable {
+    public:
+      using Representation = typename Arithmetic::Representation;
+      static constexpr int Windows = (Bits + Width - 1) / Width;
+      static constexpr std::size_t Digits = (std::size_t(1) << Width) - 1;
+
+      constexpr explicit FixedBaseTable(Representation const& base)
+          : powers_{} {
+        auto windowBase = base;
+        for (int window = 0; window < Windows; ++window) {
+          powers_[window][0] = windowBase;
+          for (std::size_t digit = 1; digit < Digits; ++digit) {
+            powers_[window][digit] =
+                Arithmetic::Multiply(powers_[window][digit - 1], windowBase);
+          }
+          windowBase =
+              Arithmetic::Multiply(powers_[window][Digits - 1], windowBase);
+        }
+      }
+
+      template <typename IntegralType>
+      static bool Covers(ExponentBits<IntegralType> const& bits) {
+        return bits.length() <= Bits;
+      }
+
+      // base^e for exponents of at most Bits bits, one for a zero exponent.
+      template <typename IntegralType>
+      Representation pow(ExponentBits<IntegralType> const& bits,
+          Representation const& one) const {
+        auto const length = bits.length();
+        auto result = one;
+        bool started = false;
+        for (int window = 0; window * Width < length; ++window) {
+          auto const low = window * Width;
+          auto const high = low + Width <= length ? low + Width - 1
+                                                  : length - 1;
+          auto const digit = bits.window(high, low);
+          if (digit == 0)
+            continue;
+
+          auto const& power = powers_[window][digit - 1];
+          result = started ? Arithmetic::Multiply(result, power) : power;
+          started = true;
+        }
+        return result;
+      }
+
+    private:
+      Representation powers_[Windows][Digits];
+    };
+
+
+    // The bit length of exponents below the order, or below the subgroup
+    // order of a Schnorr group, which is what tables of the ring's elements
+    // have to cover.
+    template <typename RingTraits,
+        typename = typename ReductionTagOf<RingTraits>::type>
+    struct OrderBits
+        : std::integral_constant<int,
+              BitLength(typename UnsignedOf<typename RingTraits::PrimaryType>::
+                      type(ExponentModulus<RingTraits>() - 1))> {};
+
+
+    // The table of the ring's generator, covering every exponent below the
+    // order. Word sized kernels are constexpr, so their table is computed
+    // at compile time; FixedUInt rings build theirs on first use.
+    template <typename RingTraits,
+        bool = IsFixedInteger<typename RingTraits::PrimaryType>::value,
+        typename = typename ReductionTagOf<RingTraits>::type>
+    struct GeneratorPowers {
+      using Arithmetic = ReductionOf<RingTraits>;
+      using Table = FixedBaseTable<Arithmetic, FixedBaseWidth,
+          OrderBits<RingTraits>::value>;
+
+      static constexpr Table Value{
+          Arithmetic::FromInteger(RingTraits::Generator)};
+
+      static Table const& Get() { return Value; }
+    };
+
+    template <typename RingTraits, bool IsFixed, typename Tag>
+    constexpr typename GeneratorPowers<RingTraits, IsFixed, Tag>::Table
+        GeneratorPowers<RingTraits, IsFixed, Tag>::Value;
+
+
+    template <typename RingTraits, typename Tag>
+    struct GeneratorPowers<RingTraits, true, Tag> {
+      using Arithmetic = ReductionOf<RingTraits>;
+      using Table = FixedBaseTable<Arithmetic, FixedBaseWidth,
+          OrderBits<RingTraits>::value>;
+
+      static Table const& Get() {
+        static Table const table{
+            Arithmetic::FromInteger(RingTraits::Generator)};
+        return table;
+      }
+    };
+
+  } // namespace detail
+} // namespace CryptoCom
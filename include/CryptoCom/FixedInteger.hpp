@@ -0,0 +1,464 @@
+#pragma once
+
+#include <CryptoCom/IntegerTraits.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+namespace CryptoCom {
+
+  // Fixed width two's complement integers over an array of 64 bit limbs,
+  // least significant limb first. They live entirely on the stack and
+  // behave like the built-in integers: arithmetic wraps around modulo
+  // 2^Bits, conversions between widths truncate or extend the sign, and
+  // division truncates towards zero.
+  //
+  // FixedUInt is meant to be the PrimaryType of rings which don't fit in a
+  // machine word, with a FixedInt a limb wider as their CoefficientType.
+  // Being of class type, the constants of such RingTraits have to be defined
+  // out of the class as well, as C++14 requires for odr-used static members.
+  template <std::size_t Bits, bool Signed = false>
+  class FixedInteger {
+  public:
+    using Limb = std::uint64_t;
+    static constexpr int LimbBits = 64;
+    static constexpr std::size_t LimbCount = Bits / LimbBits;
+
+    static_assert(Bits > 0 && Bits % LimbBits == 0,
+        "fixed integers are made of whole 64 bit limbs");
+
+  private:
+    Limb limbs_[LimbCount];
+
+    template <std::size_t, bool>
+    friend class FixedInteger;
+
+    constexpr bool isNegative() const {
+      return Signed && (limbs_[LimbCount - 1] >> (LimbBits - 1)) != 0;
+    }
+
+    constexpr std::size_t significantLimbs() const {
+      std::size_t count = LimbCount;
+      while (count > 0 && limbs_[count - 1] == 0)
+        --count;
+      return count;
+    }
+
+    constexpr int compareMagnitude(FixedInteger const& other) const {
+      for (std::size_t idx = LimbCount; idx > 0; --idx) {
+        if (limbs_[idx - 1] != other.limbs_[idx - 1])
+          return limbs_[idx - 1] < other.limbs_[idx - 1] ? -1 : 1;
+      }
+      return 0;
+    }
+
+
+    // Knuth's algorithm D on unsigned magnitudes, with UInt128 standing in
+    // for the double limb.
+    static constexpr void DivideMagnitudes(FixedInteger const& dividend,
+        FixedInteger const& divisor,
+        FixedInteger& quotient,
+        FixedInteger& remainder) {
+      quotient = FixedInteger{};
+      remainder = FixedInteger{};
+
+      auto const n = divisor.significantLimbs();
+      auto const m = dividend.significantLimbs();
+      if (n == 0)
+        throw std::domain_error("division by zero");
+
+      if (m < n) {
+        remainder = dividend;
+        return;
+      }
+
+      if (n == 1) {
+        Limb rest = 0;
+        for (std::size_t idx = m; idx > 0; --idx) {
+          auto const current =
+              (UInt128(rest) << LimbBits) | dividend.limbs_[idx - 1];
+          quotient.limbs_[idx - 1] = Limb(current / divisor.limbs_[0]);
+          rest = Limb(current % divisor.limbs_[0]);
+        }
+        remainder.limbs_[0] = rest;
+        return;
+      }
+
+      int const shift = __builtin_clzll(divisor.limbs_[n - 1]);
+      Limb v[LimbCount] = {};
+      Limb u[LimbCount + 1] = {};
+      for (std::size_t idx = n - 1; idx > 0; --idx) {
+        v[idx] = (divisor.limbs_[idx] << shift) |
+                 (shift ? divisor.limbs_[idx - 1] >> (LimbBits - shift) : 0);
+      }
+      v[0] = divisor.limbs_[0] << shift;
+      u[m] = shift ? dividend.limbs_[m - 1] >> (LimbBits - shift) : 0;
+      for (std::size_t idx = m - 1; idx > 0; --idx) {
+        u[idx] = (dividend.limbs_[idx] << shift) |
+                 (shift ? dividend.limbs_[idx - 1] >> (LimbBits - shift) : 0);
+      }
+      u[0] = dividend.limbs_[0] << shift;
+
+      for (std::size_t j = m - n + 1; j > 0; --j) {
+        auto const top = j - 1 + n;
+        auto const numerator = (UInt128(u[top]) << LimbBits) | u[top - 1];
+        auto estimate = numerator / v[n - 1];
+        auto rest = numerator % v[n - 1];
+        while ((estimate >> LimbBits) != 0 ||
+               estimate * v[n - 2] > ((rest << LimbBits) | u[top - 2])) {
+          --estimate;
+          rest += v[n - 1];
+          if ((rest >> LimbBits) != 0)
+            break;
+        }
+
+        Limb carry = 0, borrow = 0;
+        for (std::size_t idx = 0; idx < n; ++idx) {
+          auto const product = UInt128(Limb(estimate)) * v[idx] + carry;
+          carry = Limb(product >> LimbBits);
+          auto const difference =
+              UInt128(u[idx + j - 1]) - Limb(product) - borrow;
+          u[idx + j - 1] = Limb(difference);
+          borrow = Limb(difference >> LimbBits) != 0;
+        }
+        auto const difference = UInt128(u[top]) - carry - borrow;
+        u[top] = Limb(difference);
+
+        if (Limb(difference >> LimbBits) != 0) {
+          --estimate;
+          Limb sumCarry = 0;
+          for (std::size_t idx = 0; idx < n; ++idx) {
+            auto const sum = UInt128(u[idx + j - 1]) + v[idx] + sumCarry;
+            u[idx + j - 1] = Limb(sum);
+            sumCarry = Limb(sum >> LimbBits);
+          }
+          u[top] += sumCarry;
+        }
+        quotient.limbs_[j - 1] = Limb(estimate);
+      }
+
+      for (std::size_t idx = 0; idx < n; ++idx) {
+        remainder.limbs_[idx] =
+            (u[idx] >> shift) |
+            (shift ? u[idx + 1] << (LimbBits - shift) : 0);
+      }
+    }
+
+
+    static constexpr FixedInteger Divide(FixedInteger const& dividend,
+        FixedInteger const& divisor,
+        bool const wantRemainder) {
+      FixedInteger quotient, remainder;
+      DivideMagnitudes(dividend.isNegative() ? -dividend : dividend,
+          divisor.isNegative() ? -divisor : divisor,
+          quotient,
+          remainder);
+      if (wantRemainder)
+        return dividend.isNegative() ? -remainder : remainder;
+      return dividend.isNegative() != divisor.isNegative() ? -quotient
+                                                           : quotient;
+    }
+
+  public:
+    constexpr FixedInteger() noexcept : limbs_{} {}
+
+    template <typename IntegralType,
+        typename = typename std::enable_if<
+            std::is_integral<IntegralType>::value>::type>
+    constexpr FixedInteger(IntegralType const value) noexcept : limbs_{} {
+      limbs_[0] = Limb(value);
+      Limb const extension = value < 0 ? ~Limb(0) : 0;
+      for (std::size_t idx = 1; idx < LimbCount; ++idx)
+        limbs_[idx] = extension;
+    }
+
+    template <std::size_t OtherBits, bool OtherSigned>
+    constexpr FixedInteger(
+        FixedInteger<OtherBits, OtherSigned> const& other) noexcept
+        : limbs_{} {
+      Limb const extension = other.isNegative() ? ~Limb(0) : 0;
+      for (std::size_t idx = 0; idx < LimbCount; ++idx) {
+        limbs_[idx] = idx < FixedInteger<OtherBits, OtherSigned>::LimbCount
+                          ? other.limbs_[idx]
+                          : extension;
+      }
+    }
+
+
+    // Parses hexadecimal digits, with an optional 0x prefix; apostrophes can
+    // be used as digit separators.
+    static constexpr FixedInteger FromHex(char const* digits) {
+      if (digits[0] == '0' && (digits[1] == 'x' || digits[1] == 'X'))
+        digits += 2;
+
+      FixedInteger result;
+      for (; *digits != '\0'; ++digits) {
+        auto const c = *digits;
+        if (c == '\'')
+          continue;
+
+        Limb nibble = 0;
+        if (c >= '0' && c <= '9')
+          nibble = Limb(c - '0');
+        else if (c >= 'a' && c <= 'f')
+          nibble = Limb(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F')
+          nibble = Limb(c - 'A' + 10);
+        else
+          throw std::invalid_argument("not a hexadecimal digit");
+
+        result <<= 4;
+        result.limbs_[0] |= nibble;
+      }
+      return result;
+    }
+
+
+    constexpr Limb const* data() const { return limbs_; }
+    constexpr Limb* data() { return limbs_; }
+
+    template <typename IntegralType,
+        typename = typename std::enable_if<
+            std::is_integral<IntegralType>::value>::type>
+    explicit constexpr operator IntegralType() const {
+      return IntegralType(limbs_[0]);
+    }
+
+    explicit constexpr operator bool() const {
+      return significantLimbs() != 0;
+    }
+
+
+    constexpr FixedInteger& operator+=(FixedInteger const& other) {
+      Limb carry = 0;
+      for (std::size_t idx = 0; idx < LimbCount; ++idx) {
+        auto const sum = UInt128(limbs_[idx]) + other.limbs_[idx] + carry;
+        limbs_[idx] = Limb(sum);
+        carry = Limb(sum >> LimbBits);
+      }
+      return *this;
+    }
+
+    constexpr FixedInteger& operator-=(FixedInteger const& other) {
+      Limb borrow = 0;
+      for (std::size_t idx = 0; idx < LimbCount; ++idx) {
+        auto const difference =
+            UInt128(limbs_[idx]) - other.limbs_[idx] - borrow;
+        limbs_[idx] = Limb(difference);
+        borrow = Limb(difference >> LimbBits) != 0;
+      }
+      return *this;
+    }
+
+    // Schoolbook product, truncated to Bits.
+    constexpr FixedInteger& operator*=(FixedInteger const& other) {
+      FixedInteger product;
+      for (std::size_t i = 0; i < LimbCount; ++i) {
+        Limb carry = 0;
+        for (std::size_t j = 0; i + j < LimbCount; ++j) {
+          auto const term = UInt128(limbs_[i]) * other.limbs_[j] +
+                            product.limbs_[i + j] + carry;
+          product.limbs_[i + j] = Limb(term);
+          carry = Limb(term >> LimbBits);
+        }
+      }
+      return *this = product;
+    }
+
+    constexpr FixedInteger& operator/=(FixedInteger const& other) {
+      return *this = Divide(*this, other, false);
+    }
+
+    constexpr FixedInteger& operator%=(FixedInteger const& other) {
+      return *this = Divide(*this, other, true);
+    }
+
+    constexpr FixedInteger& operator<<=(int const shift) {
+      auto const limbShift = std::size_t(shift / LimbBits);
+      auto const bitShift = shift % LimbBits;
+      for (std::size_t idx = LimbCount; idx > 0; --idx) {
+        auto const target = idx - 1;
+        Limb value = 0;
+        if (target >= limbShift) {
+          value = limbs_[target - limbShift] << bitShift;
+          if (bitShift != 0 && target > limbShift)
+            value |= limbs_[target - limbShift - 1] >> (LimbBits - bitShift);
+        }
+        limbs_[target] = value;
+      }
+      return *this;
+    }
+
+    constexpr FixedInteger& operator>>=(int const shift) {
+      Limb const extension = isNegative() ? ~Limb(0) : 0;
+      auto const limbShift = std::size_t(shift / LimbBits);
+      auto const bitShift = shift % LimbBits;
+      for (std::size_t idx = 0; idx < LimbCount; ++idx) {
+        auto const source = idx + limbShift;
+        auto const low = source < LimbCount ? limbs_[source] : extension;
+        auto const high =
+            source + 1 < LimbCount ? limbs_[source + 1] : extension;
+        limbs_[idx] =
+            bitShift == 0 ? low
+                          : (low >> bitShift) | (high << (LimbBits - bitShift));
+      }
+      return *this;
+    }
+
+    constexpr FixedInteger& operator&=(FixedInteger const& other) {
+      for (std::size_t idx = 0; idx < LimbCount; ++idx)
+        limbs_[idx] &= other.limbs_[idx];
+      return *this;
+    }
+
+    constexpr FixedInteger& operator|=(FixedInteger const& other) {
+      for (std::size_t idx = 0; idx < LimbCount; ++idx)
+        limbs_[idx] |= other.limbs_[idx];
+      return *this;
+    }
+
+
+    constexpr FixedInteger operator+(FixedInteger const& other) const {
+      return FixedInteger{*this} += other;
+    }
+
+    constexpr FixedInteger operator-(FixedInteger const& other) const {
+      return FixedInteger{*this} -= other;
+    }
+
+    constexpr FixedInteger operator*(FixedInteger const& other) const {
+      return FixedInteger{*this} *= other;
+    }
+
+    constexpr FixedInteger operator/(FixedInteger const& other) const {
+      return Divide(*this, other, false);
+    }
+
+    constexpr FixedInteger operator%(FixedInteger const& other) const {
+      return Divide(*this, other, true);
+    }
+
+    constexpr FixedInteger operator<<(int const shift) const {
+      return FixedInteger{*this} <<= shift;
+    }
+
+    constexpr FixedInteger operator>>(int const shift) const {
+      return FixedInteger{*this} >>= shift;
+    }
+
+    constexpr FixedInteger operator&(FixedInteger const& other) const {
+      return FixedInteger{*this} &= other;
+    }
+
+    constexpr FixedInteger operator|(FixedInteger const& other) const {
+      return FixedInteger{*this} |= other;
+    }
+
+    constexpr FixedInteger operator~() const {
+      FixedInteger result;
+      for (std::size_t idx = 0; idx < LimbCount; ++idx)
+        result.limbs_[idx] = ~limbs_[idx];
+      return result;
+    }
+
+    constexpr FixedInteger operator-() const { return ~*this + 1; }
+
+
+    constexpr bool operator==(FixedInteger const& other) const {
+      return compareMagnitude(other) == 0;
+    }
+
+    constexpr bool operator!=(FixedInteger const& other) const {
+      return compareMagnitude(other) != 0;
+    }
+
+    constexpr bool operator<(FixedInteger const& other) const {
+      if (isNegative() != other.isNegative())
+        return isNegative();
+      return compareMagnitude(other) < 0;
+    }
+
+    constexpr bool operator>(FixedInteger const& other) const {
+      return other < *this;
+    }
+
+    constexpr bool operator<=(FixedInteger const& other) const {
+      return !(other < *this);
+    }
+
+    constexpr bool operator>=(FixedInteger const& other) const {
+      return !(*this < other);
+    }
+
+
+    friend std::ostream& operator<<(
+        std::ostream& ostr, FixedInteger const& value) {
+      if (value.isNegative())
+        return ostr << "-" << -value;
+
+      auto const flags = ostr.flags();
+      auto const fill = ostr.fill();
+      auto count = value.significantLimbs();
+      ostr << "0x" << std::hex;
+      if (count == 0) {
+        ostr << 0;
+      } else {
+        ostr << value.limbs_[--count];
+        while (count > 0)
+          ostr << std::setw(16) << std::setfill('0') << value.limbs_[--count];
+      }
+      ostr.flags(flags);
+      ostr.fill(fill);
+      return ostr;
+    }
+  };
+
+
+  template <std::size_t Bits>
+  using FixedUInt = FixedInteger<Bits, false>;
+
+  template <std::size_t Bits>
+  using FixedInt = FixedInteger<Bits, true>;
+
+
+  namespace detail {
+    template <typename T>
+    struct IsFixedInteger : public std::false_type {};
+
+    template <std::size_t Bits, bool Signed>
+    struct IsFixedInteger<FixedInteger<Bits, Signed>>
+        : public std::true_type {};
+
+    template <std::size_t Bits, bool Signed>
+    struct UnsignedOf<FixedInteger<Bits, Signed>> {
+      using type = FixedInteger<Bits, false>;
+    };
+  } // namespace detail
+} // namespace CryptoCom
+
+
+namespace std {
+  template <std::size_t Bits, bool Signed>
+  class numeric_limits<CryptoCom::FixedInteger<Bits, Signed>> {
+    using Type = CryptoCom::FixedInteger<Bits, Signed>;
+
+  public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = Signed;
+    static constexpr bool is_integer = true;
+    static constexpr bool is_exact = true;
+    static constexpr bool is_modulo = !Signed;
+    static constexpr int digits = int(Bits) - (Signed ? 1 : 0);
+    static constexpr int radix = 2;
+
+    static constexpr Type min() { return Signed ? ~max() : Type{}; }
+    static constexpr Type lowest() { return min(); }
+    static constexpr Type max() {
+      return Type(~CryptoCom::FixedUInt<Bits>{} >> (Signed ? 1 : 0));
+    }
+  };
+} // namespace std
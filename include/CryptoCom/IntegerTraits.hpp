@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+namespace CryptoCom {
+
+  // GCC and Clang provide 128 bit integers on 64 bit targets. They are an
+  // extension, so in strict ISO mode the standard type traits don't know
+  // about them, hence the detail traits below.
+  __extension__ typedef unsigned __int128 UInt128;
+
+
+  namespace detail {
+
+    template <typename T>
+    struct UnsignedOf : public std::make_unsigned<T> {};
+
+    template <>
+    struct UnsignedOf<UInt128> {
+      using type = UInt128;
+    };
+
+
+    template <typename T>
+    struct Digits
+        : public std::integral_constant<int, std::numeric_limits<T>::digits> {
+    };
+
+    template <>
+    struct Digits<UInt128> : public std::integral_constant<int, 128> {};
+
+
+    template <typename T>
+    constexpr T MaxOf() {
+      return std::numeric_limits<T>::max();
+    }
+
+    template <>
+    constexpr UInt128 MaxOf<UInt128>() {
+      return ~UInt128(0);
+    }
+
+
+    template <typename Word>
+    constexpr int BitLength(Word value) {
+      int length = 0;
+      for (; value != 0; value >>= 1)
+        ++length;
+      return length;
+    }
+
+
+    // Whether the product of any two residues modulo `order` fits into the
+    // EscalationType.
+    template <typename EscalationType, typename PrimaryType>
+    constexpr bool SquareFits(PrimaryType const order) {
+      auto const largest = EscalationType(order - 1);
+      return largest == 0 || largest <= MaxOf<EscalationType>() / largest;
+    }
+
+  } // namespace detail
+} // namespace CryptoCom
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace CryptoCom {
+  namespace detail {
+
+    // How many products of two residues a kernel's ProductBound() leaves
+    // room for, saturated to std::size_t.
+    template <typename Kernel, typename Order>
+    constexpr std::size_t ProductHeadroom(Order const order) {
+      using DoubleWord = decltype(Kernel::ProductBound());
+      auto const largest = DoubleWord(order - 1) * DoubleWord(order - 1);
+      auto const count = largest == 0 ? MaxOf<DoubleWord>()
+                                      : Kernel::ProductBound() / largest;
+      return count > MaxOf<std::size_t>() ? MaxOf<std::size_t>()
+                                          : std::size_t(count);
+    }
+
+
+    // The number of products a LazyAccumulator sums before it reduces.
+    // Kernels of word sized representations declare the largest double
+    // word their reduction takes as ProductBound() and reduce with
+    // ReduceProduct(); all others, and run time orders, have no headroom.
+    template <typename RingTraits, typename = void>
+    struct LazyHeadroom : std::integral_constant<std::size_t, 0> {};
+
+    template <typename RingTraits>
+    struct LazyHeadroom<RingTraits,
+        VoidType<decltype(ReductionOf<RingTraits>::ProductBound())>>
+        : std::integral_constant<std::size_t,
+              std::is_integral<
+                  typename ReductionOf<RingTraits>::Representation>::value
+                  ? ProductHeadroom<ReductionOf<RingTraits>>(RingTraits::Order)
+                  : 0> {};
+
+  } // namespace detail
+
+
+  // Sums of products, such as the coefficients of a polynomial product. In
+  // general every term is reduced as it is added.
+  template <typename Value, typename>
+  class LazyAccumulator {
+    Value sum_;
+
+  public:
+    LazyAccumulator() : sum_{} {}
+
+    void add(Value const& lhs, Value const& rhs) { sum_ += lhs * rhs; }
+
+    Value value() const { return sum_; }
+  };
+
+
+  // Over word sized rings the products are added up unreduced, in the
+  // double word, and the sum is reduced once as it is read. Should the
+  // sum run out of headroom first it is reduced to a single product.
+  template <typename RingTraits>
+  class LazyAccumulator<CyclicRing<RingTraits>,
+      typename std::enable_if<
+          (detail::LazyHeadroom<RingTraits>::value >= 2)>::type> {
+    using Ring = CyclicRing<RingTraits>;
+    using Arithmetic = ReductionOf<RingTraits>;
+    using Representation = typename Arithmetic::Representation;
+    using Word = typename detail::UnsignedOf<Representation>::type;
+    using DoubleWord = decltype(Arithmetic::ProductBound());
+
+    static constexpr std::size_t Headroom =
+        detail::LazyHeadroom<RingTraits>::value;
+
+    DoubleWord sum_ = 0;
+    std::size_t count_ = 0;
+
+    // The reduced sum times one, which is congruent to the sum in every
+    // representation: Montgomery's REDC divides by R, the one multiplies
+    // it back in.
+    void fold() {
+      auto const one =
+          Word(Arithmetic::FromInteger(RingTraits::MultiplicativeIdentity));
+      sum_ = DoubleWord(Word(Arithmetic::ReduceProduct(sum_))) * one;
+      count_ = 1;
+    }
+
+  public:
+    void add(Ring const& lhs, Ring const& rhs) {
+      if (count_ == Headroom)
+        fold();
+      sum_ += DoubleWord(Word(lhs.representation())) *
+              Word(rhs.representation());
+      ++count_;
+    }
+
+    Ring value() const {
+      return {typename Ring::FromRepresentation{},
+          Arithmetic::ReduceProduct(sum_)};
+    }
+  };
+
+} // namespace CryptoCom
@@ -0,0 +1,325 @@
+#pragma once
+
+#include <CryptoCom/IntegerTraits.hpp>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__)
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+namespace CryptoCom {
+  namespace detail {
+
+    // Kernels over little endian arrays of 64 bit limbs, the operand sizes
+    // are template parameters so that every loop has a fixed trip count.
+    using Limb = std::uint64_t;
+
+    // Operand sizes in limbs from which Karatsuba beats the quadratic
+    // kernels, tuned on x86-64. Squaring already saves half of the limb
+    // products, so it pays off much later.
+    constexpr std::size_t KaratsubaThreshold = 40;
+    constexpr std::size_t KaratsubaSquareThreshold = 96;
+
+
+    // Three limb accumulator of the product scanning (Comba) kernels.
+    struct ColumnAccumulator {
+      UInt128 low = 0;
+      Limb high = 0;
+
+      void add(UInt128 const value) {
+        low += value;
+        high += low < value;
+      }
+
+      Limb shift() {
+        auto const result = Limb(low);
+        low = (low >> 64) | (UInt128(high) << 64);
+        high = 0;
+        return result;
+      }
+    };
+
+
+    // out[0, 2N) = a * b, one output column at a time.
+    template <std::size_t N>
+    void MultiplyComba(Limb const* a, Limb const* b, Limb* out) {
+      ColumnAccumulator column;
+      for (std::size_t k = 0; k < 2 * N - 1; ++k) {
+        auto const first = k < N ? 0 : k - N + 1;
+        auto const last = k < N ? k : N - 1;
+        for (std::size_t i = first; i <= last; ++i)
+          column.add(UInt128(a[i]) * b[k - i]);
+        out[k] = column.shift();
+      }
+      out[2 * N - 1] = column.shift();
+    }
+
+
+    // out[0, 2N) = a * a. Every cross product a[i] * a[j] with i != j
+    // appears twice in a column, so it's computed once and doubled, which
+    // saves almost half of the limb multiplications.
+    template <std::size_t N>
+    void SquareComba(Limb const* a, Limb* out) {
+      ColumnAccumulator column;
+      for (std::size_t k = 0; k < 2 * N - 1; ++k) {
+        auto const first = k < N ? 0 : k - N + 1;
+        ColumnAccumulator cross;
+        for (std::size_t i = first; 2 * i < k; ++i)
+          cross.add(UInt128(a[i]) * a[k - i]);
+
+        column.high += (cross.high << 1) | Limb(cross.low >> 127);
+        column.add(cross.low << 1);
+        if (k % 2 == 0)
+          column.add(UInt128(a[k / 2]) * a[k / 2]);
+        out[k] = column.shift();
+      }
+      out[2 * N - 1] = column.shift();
+    }
+
+
+    // result[0, N) = a + b, returning the carry out.
+    template <std::size_t N>
+    Limb AddLimbs(Limb const* a, Limb const* b, Limb* result) {
+      Limb carry = 0;
+      for (std::size_t idx = 0; idx < N; ++idx) {
+        auto const sum = UInt128(a[idx]) + b[idx] + carry;
+        result[idx] = Limb(sum);
+        carry = Limb(sum >> 64);
+      }
+      return carry;
+    }
+
+
+    // target[0, size) += value[0, N), rippling the carry up to the end of
+    // target. Limbs of value beyond the target have to be zero.
+    template <std::size_t N>
+    void AddInto(Limb* target, std::size_t const size, Limb const* value) {
+      Limb carry = 0;
+      std::size_t idx = 0;
+      for (; idx < N && idx < size; ++idx) {
+        auto const sum = UInt128(target[idx]) + value[idx] + carry;
+        target[idx] = Limb(sum);
+        carry = Limb(sum >> 64);
+      }
+      for (; carry != 0 && idx < size; ++idx) {
+        target[idx] += carry;
+        carry = target[idx] == 0;
+      }
+    }
+
+
+    // target[0, size) -= value[0, N), the caller guarantees no underflow.
+    template <std::size_t N>
+    void SubtractFrom(
+        Limb* target, std::size_t const size, Limb const* value) {
+      Limb borrow = 0;
+      std::size_t idx = 0;
+      for (; idx < N; ++idx) {
+        auto const difference = UInt128(target[idx]) - value[idx] - borrow;
+        target[idx] = Limb(difference);
+        borrow = Limb(difference >> 64) != 0;
+      }
+      for (; borrow != 0 && idx < size; ++idx) {
+        borrow = target[idx] == 0;
+        target[idx] -= 1;
+      }
+    }
+
+
+#if defined(__x86_64__)
+    // row[0, count) += a[0, count) * multiplier, row[count] = carry, with
+    // MULX, which leaves the flags alone, so the low halves are added along
+    // the carry flag (ADCX) and the high halves along the overflow flag
+    // (ADOX), two independent chains. LEA and JRCXZ keep the loop from
+    // touching either flag.
+    __attribute__((target("bmi2,adx"))) inline void MultiplyAddRowMulx(
+        Limb* row, Limb const* a, std::size_t count, Limb const multiplier) {
+      // The loop tests the count only after its first pass.
+      if (count == 0) {
+        row[0] = 0;
+        return;
+      }
+      Limb low, high, previous = 0, scratch;
+      __asm__ volatile("xorl %k[scratch], %k[scratch]\n\t"
+                       "1:\n\t"
+                       "mulxq (%[a]), %[low], %[high]\n\t"
+                       "movq (%[row]), %[scratch]\n\t"
+                       "adcxq %[low], %[scratch]\n\t"
+                       "adoxq %[previous], %[scratch]\n\t"
+                       "movq %[scratch], (%[row])\n\t"
+                       "movq %[high], %[previous]\n\t"
+                       "leaq 8(%[a]), %[a]\n\t"
+                       "leaq 8(%[row]), %[row]\n\t"
+                       "leaq -1(%%rcx), %%rcx\n\t"
+                       "jrcxz 2f\n\t"
+                       "jmp 1b\n\t"
+                       "2:\n\t"
+                       "movq $0, %[scratch]\n\t"
+                       "adcxq %[scratch], %[previous]\n\t"
+                       "adoxq %[scratch], %[previous]\n\t"
+                       "movq %[previous], (%[row])"
+          : [row] "+r"(row),
+          [a] "+r"(a),
+          "+c"(count),
+          [low] "=&r"(low),
+          [high] "=&r"(high),
+          [previous] "+&r"(previous),
+          [scratch] "=&r"(scratch)
+          : "d"(multiplier)
+          : "cc", "memory");
+    }
+
+
+    // Operand scanning product, one MULX row per limb of b.
+    template <std::size_t N>
+    void MultiplyMulx(Limb const* a, Limb const* b, Limb* out) {
+      for (std::size_t idx = 0; idx < 2 * N; ++idx)
+        out[idx] = 0;
+      for (std::size_t i = 0; i < N; ++i)
+        MultiplyAddRowMulx(out + i, a, N, b[i]);
+    }
+
+
+    inline bool HasMulxAdx() {
+      static bool const supported = []() {
+        unsigned eax = 0, ebx = 0, ecx = 0, edx = 0;
+        if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx))
+          return false;
+        return (ebx & bit_BMI2) != 0 && (ebx & bit_ADX) != 0;
+      }();
+      return supported;
+    }
+#endif
+
+
+    // out[0, 2N) = a * b and a * a with the best kernel for the operand size
+    // and the running processor.
+    template <std::size_t N, bool = (N >= KaratsubaThreshold)>
+    struct LimbProduct;
+
+    template <std::size_t N, bool = (N >= KaratsubaSquareThreshold)>
+    struct LimbSquare;
+
+
+    // One level of Karatsuba: with a = a0 + a1 B^L and b = b0 + b1 B^L the
+    // middle term a0 b1 + a1 b0 is (a0 + a1)(b0 + b1) - a0 b0 - a1 b1, three
+    // half sized products instead of four.
+    template <std::size_t N>
+    void MultiplyKaratsuba(Limb const* a, Limb const* b, Limb* out) {
+      constexpr std::size_t L = (N + 1) / 2;
+      constexpr std::size_t H = N / 2;
+
+      LimbProduct<L>::Multiply(a, b, out);
+      LimbProduct<H>::Multiply(a + L, b + L, out + 2 * L);
+
+      Limb aSum[L] = {}, bSum[L] = {};
+      Limb aHigh[L] = {}, bHigh[L] = {};
+      for (std::size_t idx = 0; idx < H; ++idx) {
+        aHigh[idx] = a[L + idx];
+        bHigh[idx] = b[L + idx];
+      }
+      auto const aCarry = AddLimbs<L>(a, aHigh, aSum);
+      auto const bCarry = AddLimbs<L>(b, bHigh, bSum);
+
+      Limb middle[2 * L + 1] = {};
+      LimbProduct<L>::Multiply(aSum, bSum, middle);
+      if (aCarry)
+        AddInto<L>(middle + L, L + 1, bSum);
+      if (bCarry)
+        AddInto<L>(middle + L, L + 1, aSum);
+      middle[2 * L] += aCarry & bCarry;
+
+      SubtractFrom<2 * L>(middle, 2 * L + 1, out);
+      SubtractFrom<2 * H>(middle, 2 * L + 1, out + 2 * L);
+      AddInto<2 * L + 1>(out + L, 2 * N - L, middle);
+    }
+
+
+    template <std::size_t N>
+    void SquareKaratsuba(Limb const* a, Limb* out) {
+      constexpr std::size_t L = (N + 1) / 2;
+      constexpr std::size_t H = N / 2;
+
+      LimbSquare<L>::Square(a, out);
+      LimbSquare<H>::Square(a + L, out + 2 * L);
+
+      Limb sum[L] = {}, high[L] = {};
+      for (std::size_t idx = 0; idx < H; ++idx)
+        high[idx] = a[L + idx];
+      auto const carry = AddLimbs<L>(a, high, sum);
+
+      Limb middle[2 * L + 1] = {};
+      LimbSquare<L>::Square(sum, middle);
+      if (carry) {
+        AddInto<L>(middle + L, L + 1, sum);
+        AddInto<L>(middle + L, L + 1, sum);
+        middle[2 * L] += 1;
+      }
+
+      SubtractFrom<2 * L>(middle, 2 * L + 1, out);
+      SubtractFrom<2 * H>(middle, 2 * L + 1, out + 2 * L);
+      AddInto<2 * L + 1>(out + L, 2 * N - L, middle);
+    }
+
+
+    template <std::size_t N>
+    struct LimbProduct<N, false> {
+      static void Multiply(Limb const* a, Limb const* b, Limb* out) {
+#if defined(__x86_64__)
+        if (HasMulxAdx())
+          return MultiplyMulx<N>(a, b, out);
+#endif
+        MultiplyComba<N>(a, b, out);
+      }
+    };
+
+
+    template <std::size_t N>
+    struct LimbProduct<N, true> {
+      static void Multiply(Limb const* a, Limb const* b, Limb* out) {
+        MultiplyKaratsuba<N>(a, b, out);
+      }
+    };
+
+
+    template <std::size_t N>
+    struct LimbSquare<N, false> {
+      static void Square(Limb const* a, Limb* out) { SquareComba<N>(a, out); }
+    };
+
+
+    template <std::size_t N>
+    struct LimbSquare<N, true> {
+      static void Square(Limb const* a, Limb* out) {
+        SquareKaratsuba<N>(a, out);
+      }
+    };
+
+
+    // Montgomery reduction of the double width t[0, 2N) by the odd modulus
+    // n, one limb of t cleared per row (separated operand scanning). The
+    // result is t / R mod n, left in t[N, 2N) and possibly not below n yet;
+    // the returned carry is its limb above.
+    template <std::size_t N>
+    Limb MontgomeryReduceLimbs(
+        Limb* t, Limb const* n, Limb const negInverse) {
+      Limb topCarry = 0;
+      for (std::size_t i = 0; i < N; ++i) {
+        Limb const m = t[i] * negInverse;
+        Limb carry = 0;
+        for (std::size_t j = 0; j < N; ++j) {
+          auto const term = UInt128(m) * n[j] + t[i + j] + carry;
+          t[i + j] = Limb(term);
+          carry = Limb(term >> 64);
+        }
+        auto const top = UInt128(t[i + N]) + carry + topCarry;
+        t[i + N] = Limb(top);
+        topCarry = Limb(top >> 64);
+      }
+      return topCarry;
+    }
+
+  } // namespace detail
+} // namespace CryptoCom
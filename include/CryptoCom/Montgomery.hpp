@@ -0,0 +1,241 @@
+#pragma once
+
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/LimbArithmetic.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <type_traits>
+
+namespace CryptoCom {
+
+  namespace detail {
+
+    // -order^-1 modulo 2^digits(Word) by Newton iteration, each step doubles
+    // the number of correct low bits starting from the 3 bits order * order
+    // is already correct for.
+    template <typename Word>
+    constexpr Word MontgomeryNegInverse(Word const order) {
+      Word inverse = order;
+      for (int bits = 3; bits < Digits<Word>::value; bits *= 2)
+        inverse = Word(inverse * Word(Word(2) - Word(order * inverse)));
+      return Word(Word(0) - inverse);
+    }
+
+
+    // R^2 modulo order, where R = 2^digits(Word).
+    template <typename Word, typename DoubleWord>
+    constexpr Word MontgomeryRSquared(Word const order) {
+      auto const r = (DoubleWord(1) << Digits<Word>::value) % order;
+      return Word((r * r) % order);
+    }
+
+
+    // (value + m * order) / R keeping to word sized halves: the low halves
+    // cancel out, leaving a carry whenever the low half of value is nonzero.
+    template <typename Word, typename DoubleWord>
+    constexpr Word MontgomeryRedc(
+        DoubleWord const value, Word const order, Word const negInverse) {
+      Word const low = Word(value);
+      Word const m = Word(low * negInverse);
+      Word const reduced = Word(Word(value >> Digits<Word>::value) +
+                                Word((DoubleWord(m) * order) >>
+                                     Digits<Word>::value) +
+                                Word(low != 0));
+      return reduced >= order ? Word(reduced - order) : reduced;
+    }
+
+
+    // Montgomery kernel for orders which fit a machine word.
+    template <typename RingTraits>
+    struct WordMontgomery : public ModularAddition<RingTraits> {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using EscalationType = typename RingTraits::EscalationType;
+      using Representation = PrimaryType;
+
+      using Word = typename UnsignedOf<PrimaryType>::type;
+      using DoubleWord = typename UnsignedOf<EscalationType>::type;
+      static constexpr int WordBits = Digits<Word>::value;
+
+      static_assert(Digits<DoubleWord>::value >= 2 * WordBits,
+          "Montgomery form needs an EscalationType twice as wide as the "
+          "PrimaryType");
+      static_assert(RingTraits::Order % 2 == 1,
+          "Montgomery form is only defined for odd orders");
+
+      static constexpr Word Order = Word(RingTraits::Order);
+      static constexpr Word NegInverse = MontgomeryNegInverse(Order);
+      static constexpr Word RSquared =
+          MontgomeryRSquared<Word, DoubleWord>(Order);
+
+
+      static constexpr Word Redc(DoubleWord const value) {
+        return MontgomeryRedc(value, Order, NegInverse);
+      }
+
+      static constexpr Representation FromInteger(PrimaryType const value) {
+        auto const canonical =
+            ModularAddition<RingTraits>::Canonical(value);
+        return Representation(Redc(DoubleWord(Word(canonical)) * RSquared));
+      }
+
+      static constexpr PrimaryType ToInteger(Representation const value) {
+        return PrimaryType(Redc(DoubleWord(Word(value))));
+      }
+
+      static constexpr Representation Multiply(
+          Representation const lhs, Representation const rhs) {
+        return Representation(Redc(DoubleWord(Word(lhs)) * Word(rhs)));
+      }
+
+      static constexpr Representation Square(Representation const value) {
+        return Multiply(value, value);
+      }
+
+      // REDC takes any value below Order * R, so sums of products for
+      // LazyAccumulator reduce like a single one.
+      static constexpr DoubleWord ProductBound() {
+        return (DoubleWord(Order) << WordBits) - 1;
+      }
+
+      static constexpr Representation ReduceProduct(DoubleWord const value) {
+        return Representation(Redc(value));
+      }
+    };
+
+
+    // R^2 modulo order for limb arrays, where R = 2^Bits.
+    template <std::size_t Bits>
+    constexpr FixedUInt<Bits> LimbMontgomeryRSquared(
+        FixedUInt<Bits> const& order) {
+      using Wide = FixedUInt<2 * Bits + 64>;
+      return FixedUInt<Bits>((Wide(1) << int(2 * Bits)) % Wide(order));
+    }
+
+
+    // The upper half of product / R modulo order, reduced below the order.
+    template <typename PrimaryType>
+    PrimaryType LimbMontgomeryReduce(typename PrimaryType::Limb* product,
+        PrimaryType const& order, typename PrimaryType::Limb const negInverse) {
+      constexpr auto LimbCount = PrimaryType::LimbCount;
+      auto const carry =
+          MontgomeryReduceLimbs<LimbCount>(product, order.data(), negInverse);
+      PrimaryType result;
+      for (std::size_t j = 0; j < LimbCount; ++j)
+        result.data()[j] = product[LimbCount + j];
+      if (carry != 0 || result >= order)
+        result -= order;
+      return result;
+    }
+
+
+    // Montgomery kernel for FixedUInt orders. Conversions use the coarsely
+    // integrated operand scanning (CIOS) method, which is constexpr: every
+    // limb of the multiplier is followed by one limb of reduction. Ring
+    // arithmetic instead takes the full product from the fastest limb kernel
+    // and reduces it afterwards, squaring with its dedicated kernel.
+    template <typename RingTraits>
+    struct LimbMontgomery : public ModularAddition<RingTraits> {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using Representation = PrimaryType;
+      using Limb = typename PrimaryType::Limb;
+      static constexpr std::size_t LimbCount = PrimaryType::LimbCount;
+      static constexpr int LimbBits = PrimaryType::LimbBits;
+
+      static_assert((RingTraits::Order.data()[0] & 1) == 1,
+          "Montgomery form is only defined for odd orders");
+
+      static constexpr PrimaryType Order = RingTraits::Order;
+      static constexpr Limb NegInverse =
+          MontgomeryNegInverse(RingTraits::Order.data()[0]);
+      static constexpr PrimaryType RSquared =
+          LimbMontgomeryRSquared(RingTraits::Order);
+
+
+      static constexpr PrimaryType MultiplyLimbs(
+          PrimaryType const& lhs, PrimaryType const& rhs) {
+        auto const a = lhs.data();
+        auto const b = rhs.data();
+        auto const n = Order.data();
+        Limb t[LimbCount + 2] = {};
+
+        for (std::size_t i = 0; i < LimbCount; ++i) {
+          Limb carry = 0;
+          for (std::size_t j = 0; j < LimbCount; ++j) {
+            auto const term = UInt128(a[j]) * b[i] + t[j] + carry;
+            t[j] = Limb(term);
+            carry = Limb(term >> LimbBits);
+          }
+          auto const top = UInt128(t[LimbCount]) + carry;
+          t[LimbCount] = Limb(top);
+          t[LimbCount + 1] = Limb(top >> LimbBits);
+
+          Limb const m = Limb(t[0] * NegInverse);
+          carry = Limb((UInt128(m) * n[0] + t[0]) >> LimbBits);
+          for (std::size_t j = 1; j < LimbCount; ++j) {
+            auto const term = UInt128(m) * n[j] + t[j] + carry;
+            t[j - 1] = Limb(term);
+            carry = Limb(term >> LimbBits);
+          }
+          auto const shifted = UInt128(t[LimbCount]) + carry;
+          t[LimbCount - 1] = Limb(shifted);
+          t[LimbCount] = t[LimbCount + 1] + Limb(shifted >> LimbBits);
+        }
+
+        PrimaryType result;
+        for (std::size_t j = 0; j < LimbCount; ++j)
+          result.data()[j] = t[j];
+        if (t[LimbCount] != 0 || result >= Order)
+          result -= Order;
+        return result;
+      }
+
+      static PrimaryType Reduce(Limb* product) {
+        return LimbMontgomeryReduce(product, Order, NegInverse);
+      }
+
+      static constexpr Representation FromInteger(PrimaryType const value) {
+        return MultiplyLimbs(
+            ModularAddition<RingTraits>::Canonical(value), RSquared);
+      }
+
+      static constexpr PrimaryType ToInteger(Representation const value) {
+        return MultiplyLimbs(value, PrimaryType(1));
+      }
+
+      static Representation Multiply(
+          Representation const& lhs, Representation const& rhs) {
+        Limb product[2 * LimbCount];
+        LimbProduct<LimbCount>::Multiply(lhs.data(), rhs.data(), product);
+        return Reduce(product);
+      }
+
+      static Representation Square(Representation const& value) {
+        Limb product[2 * LimbCount];
+        LimbSquare<LimbCount>::Square(value.data(), product);
+        return Reduce(product);
+      }
+    };
+
+    template <typename RingTraits>
+    constexpr typename RingTraits::PrimaryType
+        LimbMontgomery<RingTraits>::Order;
+
+    template <typename RingTraits>
+    constexpr typename RingTraits::PrimaryType
+        LimbMontgomery<RingTraits>::RSquared;
+
+  } // namespace detail
+
+
+  // Montgomery form keeps x * R mod Order in the ring and multiplies with
+  // REDC, so multiplication needs no division at all. Conversion to and from
+  // the form happens only when an element is constructed from or read back
+  // as an integer.
+  template <typename RingTraits>
+  struct ReductionKernel<MontgomeryReduction, RingTraits>
+      : public std::conditional<
+            detail::IsFixedInteger<typename RingTraits::PrimaryType>::value,
+            detail::LimbMontgomery<RingTraits>,
+            detail::WordMontgomery<RingTraits>>::type {};
+
+} // namespace CryptoCom
@@ -0,0 +1,240 @@
+#pragma once
+
+#include <CryptoCom/BatchPow.hpp>
+#include <CryptoCom/Exponent.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace CryptoCom {
+  namespace detail {
+
+    // The group operation of the elements MultiExp combines. Elements which
+    // multiply with each other, like those of a CyclicRing, form a group
+    // under multiplication with One() as its identity. All others are
+    // written additively, like the ciphers of ExponentialElGamal, with
+    // Zero() as their identity and multiplication by a scalar as the
+    // power.
+    template <typename Element, typename = void>
+    struct GroupOperations {
+      static Element Identity() { return Element::Zero(); }
+
+      static Element Combine(Element const& lhs, Element const& rhs) {
+        return lhs + rhs;
+      }
+    };
+
+    template <typename Element>
+    struct GroupOperations<Element,
+        VoidType<decltype(
+            std::declval<Element const&>() * std::declval<Element const&>())>> {
+      static Element Identity() { return Element::One(); }
+
+      static Element Combine(Element const& lhs, Element const& rhs) {
+        return lhs * rhs;
+      }
+    };
+
+
+    // Group operations for a product of n powers of exponents of `length`
+    // bits by Straus' method with w bit windows: 2^w - 2 per base for the
+    // table of its powers, one per window and base, and the squarings.
+    inline std::size_t StrausCost(
+        std::size_t const count, int const length, int const width) {
+      auto const windows = std::size_t((length + width - 1) / width);
+      return count * ((std::size_t(1) << width) - 2) + count * windows +
+             std::size_t(length);
+    }
+
+    // The same by Pippenger's bucket method with w bit windows: one per
+    // window and base to sort it into the bucket of its digit, two per
+    // bucket to sum them up weighted, and the squarings.
+    inline std::size_t PippengerCost(
+        std::size_t const count, int const length, int const width) {
+      auto const windows = std::size_t((length + width - 1) / width);
+      return windows * (count + 2 * ((std::size_t(1) << width) - 1)) +
+             std::size_t(length);
+    }
+
+    template <typename Cost>
+    int CheapestWidth(Cost const cost, int const maxWidth) {
+      int best = 1;
+      for (int width = 2; width <= maxWidth; ++width) {
+        if (cost(width) < cost(best))
+          best = width;
+      }
+      return best;
+    }
+
+    constexpr int StrausMaxWidth = 6;
+    constexpr int PippengerMaxWidth = 16;
+
+
+    template <typename Bits>
+    std::uint32_t DigitOf(Bits const& bits, int const window, int const width) {
+      auto const low = window * width;
+      auto const high = std::min(low + width, int(Bits::MaxLength)) - 1;
+      return bits.window(high, low);
+    }
+
+
+    // Straus' interleaved exponentiation (Shamir's trick for two bases): the
+    // powers base^1 ... base^(2^w - 1) of every base are tabulated, then the
+    // product is squared once per bit of the longest exponent, shared by
+    // all bases, and multiplied with the table entry of every base's digit
+    // once per window.
+    template <typename Element, typename Bits>
+    Element StrausMultiExp(std::vector<Element> const& bases,
+        std::vector<Bits> const& bits, int const length, int const width) {
+      using Group = GroupOperations<Element>;
+      auto const digits = (std::size_t(1) << width) - 1;
+
+      std::vector<Element> table;
+      table.reserve(bases.size() * digits);
+      for (auto const& base : bases) {
+        table.push_back(base);
+        for (std::size_t digit = 1; digit < digits; ++digit)
+          table.push_back(Group::Combine(table.back(), base));
+      }
+
+      auto result = Group::Identity();
+      bool started = false;
+      for (auto window = (length - 1) / width; window >= 0; --window) {
+        for (int bit = 0; started && bit < width; ++bit)
+          result = Group::Combine(result, result);
+        for (std::size_t idx = 0; idx < bases.size(); ++idx) {
+          auto const digit = DigitOf(bits[idx], window, width);
+          if (digit == 0)
+            continue;
+          auto const& power = table[idx * digits + digit - 1];
+          result = started ? Group::Combine(result, power) : power;
+          started = true;
+        }
+      }
+      return result;
+    }
+
+
+    // Pippenger's bucket method: per w bit window every base goes into the
+    // bucket of its digit, at the cost of one operation, and the buckets
+    // B_1 ... B_(2^w - 1) are weighted by a running sum, B_d^d being
+    // the product of the running products from the top bucket down. With
+    // w near log n this takes about b n / log n operations for b bit
+    // exponents, against b n / w for Straus, which is limited to small w by
+    // its tables.
+    template <typename Element, typename Bits>
+    Element PippengerMultiExp(std::vector<Element> const& bases,
+        std::vector<Bits> const& bits, int const length, int const width) {
+      using Group = GroupOperations<Element>;
+      auto const digits = (std::size_t(1) << width) - 1;
+
+      std::vector<Element> buckets(digits, Group::Identity());
+      std::vector<bool> filled(digits);
+      auto result = Group::Identity();
+      bool started = false;
+      for (auto window = (length - 1) / width; window >= 0; --window) {
+        for (int bit = 0; started && bit < width; ++bit)
+          result = Group::Combine(result, result);
+
+        std::fill(filled.begin(), filled.end(), false);
+        for (std::size_t idx = 0; idx < bases.size(); ++idx) {
+          auto const digit = DigitOf(bits[idx], window, width);
+          if (digit == 0)
+            continue;
+          auto& bucket = buckets[digit - 1];
+          bucket = filled[digit - 1] ? Group::Combine(bucket, bases[idx])
+                                     : bases[idx];
+          filled[digit - 1] = true;
+        }
+
+        auto running = Group::Identity(), total = Group::Identity();
+        bool hasRunning = false, hasTotal = false;
+        for (auto digit = digits; digit > 0; --digit) {
+          if (filled[digit - 1]) {
+            running = hasRunning ? Group::Combine(running, buckets[digit - 1])
+                                 : buckets[digit - 1];
+            hasRunning = true;
+          }
+          if (hasRunning) {
+            total = hasTotal ? Group::Combine(total, running) : running;
+            hasTotal = true;
+          }
+        }
+        if (hasTotal) {
+          result = started ? Group::Combine(result, total) : total;
+          started = true;
+        }
+      }
+      return result;
+    }
+
+  } // namespace detail
+
+
+  // The product base_1^e_1 ... base_n^e_n of the bases of [first, last) and
+  // the exponents at the same positions from `exponents`, which are
+  // non-negative integers or ring elements. Bases are CyclicRing elements,
+  // or elements of any other group the library defines, such as the
+  // ciphers of ExponentialElGamal, where the product is a sum and the
+  // powers are multiples. The method, Straus' for few bases or Pippenger's
+  // for many, and its window width are chosen by counting the group
+  // operations each would take.
+  template <typename InputIt, typename ExponentIt>
+  typename std::iterator_traits<InputIt>::value_type MultiExp(
+      InputIt first, InputIt last, ExponentIt exponents) {
+    using Element = typename std::iterator_traits<InputIt>::value_type;
+    using Exponent = decltype(detail::PlainExponent(*exponents));
+    using Bits = detail::ExponentBits<Exponent>;
+
+    std::vector<Element> bases;
+    std::vector<Bits> bits;
+    int length = 0;
+    for (; first != last; ++first, ++exponents) {
+      auto const exponent = detail::PlainExponent(*exponents);
+      if (detail::IsNegative(exponent))
+        throw std::invalid_argument("MultiExp takes non-negative exponents");
+      bits.emplace_back(exponent);
+      if (bits.back().length() == 0) {
+        bits.pop_back();
+        continue;
+      }
+      bases.push_back(*first);
+      length = std::max(length, bits.back().length());
+    }
+    if (bases.empty())
+      return detail::GroupOperations<Element>::Identity();
+
+    auto const count = bases.size();
+    auto const straus = detail::CheapestWidth(
+        [=](int const width) {
+          return detail::StrausCost(count, length, width);
+        },
+        detail::StrausMaxWidth);
+    auto const pippenger = detail::CheapestWidth(
+        [=](int const width) {
+          return detail::PippengerCost(count, length, width);
+        },
+        std::min(detail::PippengerMaxWidth, length));
+
+    if (detail::StrausCost(count, length, straus) <=
+        detail::PippengerCost(count, length, pippenger)) {
+      return detail::StrausMultiExp(bases, bits, length, straus);
+    }
+    return detail::PippengerMultiExp(bases, bits, length, pippenger);
+  }
+
+
+  template <typename Bases, typename Exponents>
+  typename Bases::value_type MultiExp(
+      Bases const& bases, Exponents const& exponents) {
+    if (bases.size() != exponents.size())
+      throw std::invalid_argument("as many exponents as bases are needed");
+    return MultiExp(bases.begin(), bases.end(), exponents.begin());
+  }
+
+} // namespace CryptoCom
@@ -0,0 +1,414 @@
+#pragma once
+
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Montgomery.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+namespace CryptoCom {
+  namespace detail {
+
+    constexpr int TwoAdicity(std::uint64_t value) {
+      int adicity = 0;
+      while (value != 0 && value % 2 == 0) {
+        value /= 2;
+        ++adicity;
+      }
+      return adicity;
+    }
+
+    constexpr std::uint64_t PowModulo(std::uint64_t base,
+        std::uint64_t exponent, std::uint64_t const modulus) {
+      std::uint64_t result = 1 % modulus;
+      base %= modulus;
+      for (; exponent != 0; exponent /= 2) {
+        if (exponent % 2 == 1)
+          result = std::uint64_t(UInt128(result) * base % modulus);
+        base = std::uint64_t(UInt128(base) * base % modulus);
+      }
+      return result;
+    }
+
+    // An element of order 2^k modulo an odd modulus with 2^k | modulus - 1:
+    // c^((modulus - 1) / 2^k) for the first small c whose 2^(k-1)-th power
+    // of it is -1, which for a prime is any quadratic non-residue. Zero if
+    // there is none among the candidates.
+    constexpr std::uint64_t RootOfUnity(
+        std::uint64_t const modulus, int const k) {
+      for (std::uint64_t c = 2; c < 64 && c < modulus; ++c) {
+        auto const root = PowModulo(c, (modulus - 1) >> k, modulus);
+        if (PowModulo(root, std::uint64_t(1) << (k - 1), modulus) ==
+            modulus - 1) {
+          return root;
+        }
+      }
+      return 0;
+    }
+
+
+    // Rings of a word sized prime order N = c 2^m + 1, declared PrimeOrder,
+    // transform 2^LogSize = 2^m points; all others none.
+    template <typename RingTraits,
+        bool = HasConstantWordOrder<RingTraits>{} &&
+               HasPrimeOrder<RingTraits>{}>
+    struct TransformParameters {
+      static constexpr int LogSize = 0;
+      static constexpr std::uint64_t Root = 0;
+    };
+
+    template <typename RingTraits>
+    struct TransformParameters<RingTraits, true> {
+      static constexpr auto Order = std::uint64_t(RingTraits::Order);
+      static constexpr int Adicity =
+          Order % 2 == 1 ? std::min(TwoAdicity(Order - 1), 62) : 0;
+      static constexpr std::uint64_t Root =
+          Adicity > 0 ? RootOfUnity(Order, Adicity) : 0;
+      static constexpr int LogSize = Root == 0 ? 0 : Adicity;
+    };
+
+  } // namespace detail
+
+
+  // In-place number-theoretic transforms of 2^k points over a ring whose
+  // order is a prime of the form c 2^m + 1, for k <= m. The forward
+  // transform is decimation in frequency, taking the coefficients in
+  // their natural order to the values at the powers of the root in bit
+  // reversed order; the inverse is decimation in time from there back to
+  // the natural order, so a convolution never permutes its points. Two
+  // radix-2 stages are fused into one radix-4 pass over the points
+  // wherever possible, halving the passes through memory.
+  template <typename RingTraits>
+  class NumberTheoreticTransform {
+    using Ring = CyclicRing<RingTraits>;
+    using Parameters = detail::TransformParameters<RingTraits>;
+
+    // The twiddle factors w_2h^j for 0 <= j < h at position h + j, w_2h
+    // being the root of order 2h. Every stage reads its factors in a row
+    // and the table for n points begins the one for 2n points.
+    struct Twiddles {
+      std::vector<Ring> forward, inverse;
+    };
+
+  public:
+    static constexpr int MaxLogSize = Parameters::LogSize;
+
+    // The most points a transform takes, zero for rings without any.
+    static constexpr std::size_t MaxSize() {
+      return MaxLogSize == 0 ? 0
+             : MaxLogSize < detail::Digits<std::size_t>::value - 1
+                 ? std::size_t(1) << MaxLogSize
+                 : std::size_t(1) << (detail::Digits<std::size_t>::value - 2);
+    }
+
+    static void Forward(Ring* values, std::size_t const size) {
+      auto const twiddles = TwiddlesFor(size);
+      auto const* w = twiddles->forward.data();
+      auto h = size / 2;
+      for (; h >= 2; h /= 4) {
+        auto const q = h / 2;
+        for (std::size_t start = 0; start < size; start += 4 * q) {
+          auto* x = values + start;
+          for (std::size_t j = 0; j < q; ++j) {
+            auto const a0 = x[j], a1 = x[j + q];
+            auto const a2 = x[j + 2 * q], a3 = x[j + 3 * q];
+            auto const b0 = a0 + a2, b1 = a1 + a3;
+            auto const c0 = (a0 - a2) * w[2 * q + j];
+            auto const c1 = (a1 - a3) * w[3 * q + j];
+            x[j] = b0 + b1;
+            x[j + q] = (b0 - b1) * w[q + j];
+            x[j + 2 * q] = c0 + c1;
+            x[j + 3 * q] = (c0 - c1) * w[q + j];
+          }
+        }
+      }
+      if (h == 1) {
+        for (std::size_t start = 0; start < size; start += 2) {
+          auto const a0 = values[start], a1 = values[start + 1];
+          values[start] = a0 + a1;
+          values[start + 1] = a0 - a1;
+        }
+      }
+    }
+
+    // The inverse of Forward, including the division by the size.
+    static void Inverse(Ring* values, std::size_t const size) {
+      auto const twiddles = TwiddlesFor(size);
+      auto const* w = twiddles->inverse.data();
+      std::size_t q = 1;
+      if (detail::TwoAdicity(size) % 2 == 1) {
+        for (std::size_t start = 0; start < size; start += 2) {
+          auto const a0 = values[start], a1 = values[start + 1];
+          values[start] = a0 + a1;
+          values[start + 1] = a0 - a1;
+        }
+        q = 2;
+      }
+      for (; q < size; q *= 4) {
+        for (std::size_t start = 0; start < size; start += 4 * q) {
+          auto* x = values + start;
+          for (std::size_t j = 0; j < q; ++j) {
+            auto const v1 = x[j + q] * w[q + j];
+            auto const v3 = x[j + 3 * q] * w[q + j];
+            auto const b0 = x[j] + v1, b1 = x[j] - v1;
+            auto const c0 = (x[j + 2 * q] + v3) * w[2 * q + j];
+            auto const c1 = (x[j + 2 * q] - v3) * w[3 * q + j];
+            x[j] = b0 + c0;
+            x[j + q] = b1 + c1;
+            x[j + 2 * q] = b0 - c0;
+            x[j + 3 * q] = b1 - c1;
+          }
+        }
+      }
+
+      auto const scale = Ring{typename RingTraits::PrimaryType(
+          size % std::uint64_t(RingTraits::Order))}.inverse();
+      for (std::size_t idx = 0; idx < size; ++idx)
+        values[idx] = values[idx] * scale;
+    }
+
+    // Doubles a transform: with values[0, size) the Forward transform of a
+    // polynomial of count <= size coefficients, values[0, 2 size) becomes
+    // its transform of 2 size points. In bit reversed order those begin
+    // with the values at the even powers of the root of order 2 size, the
+    // transform already there, and end with those at the odd powers, the
+    // transform of the coefficients twisted by w_2size^i.
+    static void Extend(Ring const* coefficients, std::size_t const count,
+        Ring* values, std::size_t const size) {
+      auto const twiddles = TwiddlesFor(2 * size);
+      auto const* twist = twiddles->forward.data() + size;
+      auto* odd = values + size;
+      for (std::size_t idx = 0; idx < size; ++idx)
+        odd[idx] = idx < count ? coefficients[idx] * twist[idx] : Ring::Zero();
+      Forward(odd, size);
+    }
+
+  private:
+    // Tables are built once per ring, for the largest transform yet, and
+    // shared by all transforms up to that size.
+    static std::shared_ptr<Twiddles const> TwiddlesFor(
+        std::size_t const size) {
+      static std::mutex mutex;
+      static std::shared_ptr<Twiddles const> cached;
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (cached && cached->forward.size() >= size)
+        return cached;
+
+      auto twiddles = std::make_shared<Twiddles>();
+      twiddles->forward.resize(size, Ring::One());
+      twiddles->inverse.resize(size, Ring::One());
+      auto const root =
+          Ring{typename RingTraits::PrimaryType(Parameters::Root)};
+      for (std::size_t h = 1; h < size; h *= 2) {
+        auto const logOrder = detail::TwoAdicity(2 * h);
+        auto const w = root.pow(std::uint64_t(1) << (MaxLogSize - logOrder));
+        auto const inverse = w.inverse();
+        for (std::size_t j = 1; j < h; ++j) {
+          twiddles->forward[h + j] = twiddles->forward[h + j - 1] * w;
+          twiddles->inverse[h + j] = twiddles->inverse[h + j - 1] * inverse;
+        }
+      }
+      cached = std::move(twiddles);
+      return cached;
+    }
+  };
+
+
+  namespace detail {
+
+    // Operands shorter than these are left to Karatsuba's method: the
+    // transforms of a single prime from here, the three of the Chinese
+    // remainder theorem from a good deal further.
+    constexpr std::size_t TransformThreshold = 64;
+    constexpr std::size_t CrtTransformThreshold = 512;
+
+
+    // The transform polynomials over a coefficient type may be held in:
+    // the ring's own, or none, of MaxSize() zero, for all others.
+    struct NoTransform {
+      static constexpr std::size_t MaxSize() { return 0; }
+
+      template <typename CoefficientType>
+      static void Forward(CoefficientType*, std::size_t) {}
+
+      template <typename CoefficientType>
+      static void Inverse(CoefficientType*, std::size_t) {}
+
+      template <typename CoefficientType>
+      static void Extend(CoefficientType const*, std::size_t, CoefficientType*,
+          std::size_t) {}
+    };
+
+    template <typename CoefficientType>
+    struct TransformOf {
+      using type = NoTransform;
+    };
+
+    template <typename RingTraits>
+    struct TransformOf<CyclicRing<RingTraits>> {
+      using type = NumberTheoreticTransform<RingTraits>;
+    };
+
+
+    template <std::int64_t Prime>
+    struct TransformPrimeTraits {
+      using PrimaryType = std::int64_t;
+      using EscalationType = UInt128;
+      using CoefficientType = std::int64_t;
+      using Reduction = MontgomeryReduction;
+
+      static constexpr PrimaryType Order{Prime};
+      static constexpr PrimaryType Generator{3};
+      static constexpr PrimaryType AdditiveIdentity{0};
+      static constexpr PrimaryType MultiplicativeIdentity{1};
+      static constexpr bool PrimeOrder = true;
+    };
+
+    template <std::int64_t Prime>
+    constexpr std::int64_t TransformPrimeTraits<Prime>::Order;
+
+    // Primes c 2^40 + 1 below 2^62, their product above 2^185. Products of
+    // polynomials over any word sized ring have coefficients below n N^2 <
+    // n 2^126, which they pin down for all n below 2^59.
+    using CrtPrime0 = TransformPrimeTraits<4611615649683210241>;
+    using CrtPrime1 = TransformPrimeTraits<4611613450659954689>;
+    using CrtPrime2 = TransformPrimeTraits<4611549678985543681>;
+
+
+    // out[0, n + m - 1) = a[0, n) * b[0, m) as the inverse transform of the
+    // product of the operands' transforms.
+    template <typename RingTraits>
+    void TransformProduct(CyclicRing<RingTraits> const* a, std::size_t const n,
+        CyclicRing<RingTraits> const* b, std::size_t const m,
+        CyclicRing<RingTraits>* out) {
+      using Ring = CyclicRing<RingTraits>;
+      using Transform = NumberTheoreticTransform<RingTraits>;
+      std::size_t size = 1;
+      while (size < n + m - 1)
+        size *= 2;
+
+      std::vector<Ring> lhs(size, Ring::Zero()), rhs(size, Ring::Zero());
+      std::copy(a, a + n, lhs.begin());
+      std::copy(b, b + m, rhs.begin());
+      Transform::Forward(lhs.data(), size);
+      Transform::Forward(rhs.data(), size);
+      for (std::size_t idx = 0; idx < size; ++idx)
+        lhs[idx] = lhs[idx] * rhs[idx];
+      Transform::Inverse(lhs.data(), size);
+      std::copy(lhs.begin(), lhs.begin() + (n + m - 1), out);
+    }
+
+
+    template <typename PrimeTraits, typename RingTraits>
+    std::vector<CyclicRing<PrimeTraits>> ResiduesOf(
+        CyclicRing<RingTraits> const* values, std::size_t const count) {
+      std::vector<CyclicRing<PrimeTraits>> residues;
+      residues.reserve(count);
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        residues.emplace_back(std::int64_t(
+            std::uint64_t(values[idx].ordinalIndex()) %
+            std::uint64_t(PrimeTraits::Order)));
+      }
+      return residues;
+    }
+
+    template <typename PrimeTraits, typename RingTraits>
+    std::vector<CyclicRing<PrimeTraits>> ResidueProduct(
+        CyclicRing<RingTraits> const* a, std::size_t const n,
+        CyclicRing<RingTraits> const* b, std::size_t const m) {
+      auto const lhs = ResiduesOf<PrimeTraits>(a, n);
+      auto const rhs = ResiduesOf<PrimeTraits>(b, m);
+      std::vector<CyclicRing<PrimeTraits>> product(n + m - 1);
+      TransformProduct(lhs.data(), n, rhs.data(), m, product.data());
+      return product;
+    }
+
+
+    // The product over the integers, modulo three transform primes, and
+    // the coefficients recovered modulo the ring's order by Garner's form
+    // of the Chinese remainder theorem: x = t0 + p0 t1 + p0 p1 t2 with t_i
+    // below p_i.
+    template <typename RingTraits>
+    void CrtTransformProduct(CyclicRing<RingTraits> const* a,
+        std::size_t const n, CyclicRing<RingTraits> const* b,
+        std::size_t const m, CyclicRing<RingTraits>* out) {
+      using Ring = CyclicRing<RingTraits>;
+      using Primary = typename RingTraits::PrimaryType;
+      using Ring1 = CyclicRing<CrtPrime1>;
+      using Ring2 = CyclicRing<CrtPrime2>;
+      auto const p0 = std::uint64_t(CrtPrime0::Order);
+      auto const p1 = std::uint64_t(CrtPrime1::Order);
+      auto const p2 = std::uint64_t(CrtPrime2::Order);
+      auto const order = std::uint64_t(RingTraits::Order);
+
+      auto const r0 = ResidueProduct<CrtPrime0>(a, n, b, m);
+      auto const r1 = ResidueProduct<CrtPrime1>(a, n, b, m);
+      auto const r2 = ResidueProduct<CrtPrime2>(a, n, b, m);
+
+      auto const p0Inverse1 = Ring1{std::int64_t(p0 % p1)}.inverse();
+      auto const p0Inverse2 =
+          Ring2{std::int64_t(p0 % p2)}.inverse();
+      auto const p1Inverse2 = Ring2{std::int64_t(p1 % p2)}.inverse();
+      auto const p0Modulo = Ring{Primary(p0 % order)};
+      auto const p0p1Modulo =
+          Ring{Primary(std::uint64_t(UInt128(p0) * p1 % order))};
+
+      for (std::size_t k = 0; k < n + m - 1; ++k) {
+        auto const t0 = std::uint64_t(r0[k].ordinalIndex());
+        auto const t1 = (r1[k] - Ring1{std::int64_t(t0 % p1)}) * p0Inverse1;
+        auto const t1Value = std::uint64_t(t1.ordinalIndex());
+        auto const t2 = ((r2[k] - Ring2{std::int64_t(t0 % p2)}) * p0Inverse2 -
+                            Ring2{std::int64_t(t1Value % p2)}) *
+                        p1Inverse2;
+        out[k] = Ring{Primary(t0 % order)} +
+                 p0Modulo * Ring{Primary(t1Value % order)} +
+                 p0p1Modulo *
+                     Ring{Primary(std::uint64_t(t2.ordinalIndex()) % order)};
+      }
+    }
+
+
+    // Products of polynomials by transforms, where the coefficients allow
+    // for them: rings of a word sized order, by a transform of their own
+    // if the order is a suitable prime and by the Chinese remainder
+    // theorem otherwise. Multiply() declines anything else, or operands too
+    // short to gain from it, by returning false.
+    template <typename CoefficientType, typename = void>
+    struct TransformMultiplication {
+      static bool Multiply(CoefficientType const*, std::size_t,
+          CoefficientType const*, std::size_t, CoefficientType*) {
+        return false;
+      }
+    };
+
+    template <typename RingTraits>
+    struct TransformMultiplication<CyclicRing<RingTraits>,
+        typename std::enable_if<HasConstantWordOrder<RingTraits>{}>::type> {
+      using Ring = CyclicRing<RingTraits>;
+
+      static bool Multiply(Ring const* a, std::size_t const n, Ring const* b,
+          std::size_t const m, Ring* out) {
+        auto const shorter = std::min(n, m);
+        if (shorter >= TransformThreshold &&
+            n + m - 1 <= NumberTheoreticTransform<RingTraits>::MaxSize()) {
+          TransformProduct(a, n, b, m, out);
+          return true;
+        }
+        if (shorter >= CrtTransformThreshold) {
+          CrtTransformProduct(a, n, b, m, out);
+          return true;
+        }
+        return false;
+      }
+    };
+
+  } // namespace detail
+
+} // namespace CryptoCom
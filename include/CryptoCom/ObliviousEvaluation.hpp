@@ -3,14 +3,77 @@
 #include <CryptoCom/CyclicRing.hpp>
 #include <CryptoCom/ExponentialElGamal.hpp>
 #include <CryptoCom/Polynomial.hpp>
+#include <CryptoCom/RemainderTree.hpp>
 
 #include <algorithm>
 #include <map>
 #include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace CryptoCom {
   namespace ObliviousEvaluation {
 
+    namespace detail {
+      // Encryption systems may decrypt a range of ciphers at once, which the
+      // client prefers over one decryption per cipher.
+      template <typename EncryptionSystem, typename Key, typename Ciphers,
+          typename = void>
+      struct HasBatchDecryption : public std::false_type {};
+
+      template <typename EncryptionSystem, typename Key, typename Ciphers>
+      struct HasBatchDecryption<EncryptionSystem, Key, Ciphers,
+          CryptoCom::detail::VoidType<decltype(EncryptionSystem::DecryptBatch(
+              std::declval<Key const&>(),
+              std::declval<Ciphers const&>().cbegin(),
+              std::declval<Ciphers const&>().cend()))>>
+          : public std::true_type {};
+
+
+      template <typename EncryptionSystem, typename Key, typename Ciphers>
+      auto DecryptAll(Key const& key, Ciphers const& ciphers, std::true_type) {
+        return EncryptionSystem::DecryptBatch(
+            key, ciphers.cbegin(), ciphers.cend());
+      }
+
+      template <typename EncryptionSystem, typename Key, typename Ciphers>
+      auto DecryptAll(Key const& key, Ciphers const& ciphers, std::false_type) {
+        std::vector<decltype(EncryptionSystem::Decrypt(key, *ciphers.cbegin()))>
+            plainTexts;
+        for (auto const& cipher : ciphers)
+          plainTexts.push_back(EncryptionSystem::Decrypt(key, cipher));
+        return plainTexts;
+      }
+
+      template <typename EncryptionSystem, typename Key, typename Ciphers>
+      auto DecryptAll(Key const& key, Ciphers const& ciphers) {
+        return DecryptAll<EncryptionSystem>(key, ciphers,
+            HasBatchDecryption<EncryptionSystem, Key, Ciphers>{});
+      }
+
+
+      // Servers over word sized rings whose exponents have a known modulus
+      // evaluate by a remainder tree, which takes ciphers that subtract, as
+      // those of exponential ElGamal do. Other rings stay with Horner's
+      // scheme.
+      template <typename RingType, typename Cipher, typename = void>
+      struct HasRemainderTree : public std::false_type {};
+
+      template <typename RingType, typename Cipher>
+      struct HasRemainderTree<RingType, Cipher,
+          CryptoCom::detail::VoidType<typename RingType::Traits,
+              decltype(Cipher::Zero()),
+              decltype(std::declval<Cipher const&>() -
+                       std::declval<Cipher const&>())>>
+          : public std::integral_constant<bool,
+                CryptoCom::detail::HasConstantWordOrder<
+                    typename RingType::Traits>::value &&
+                    CryptoCom::detail::HasExponentOrder<
+                        typename RingType::Traits>::value> {};
+    } // namespace detail
+
+
     template <typename RingType,
         typename InputType,
         typename EncryptionSystem =
@@ -27,7 +90,11 @@ namespace CryptoCom {
       Polynomial<Cipher> const encryptedPolynomial_;
 
     public:
-      ClientSet(RingType publicKey,
+      // The public key is either a Ring or anything else the encryption
+      // system's Encrypt accepts, such as a PreparedPublicKey, which pays
+      // off as every coefficient is encrypted under the same key.
+      template <typename PublicKey>
+      ClientSet(PublicKey const& publicKey,
           RingType privateKey,
           std::set<InputType> const& privateSet,
           RNG rng)
@@ -64,8 +131,9 @@ namespace CryptoCom {
           std::set<Cipher> const& evaluatedElements,
           RingType const& privateKey) const {
         std::set<InputType> results;
-        for (auto const& e : evaluatedElements) {
-          auto const decryptedElem = EncryptionSystem::Decrypt(privateKey, e);
+        auto const decrypted = detail::DecryptAll<EncryptionSystem>(
+            privateKey, evaluatedElements);
+        for (auto const& decryptedElem : decrypted) {
           auto const it = deciphered_.find(decryptedElem);
           if (it != deciphered_.end())
             results.insert(it->second);
@@ -90,17 +158,45 @@ namespace CryptoCom {
       using Cipher = typename EncryptionSystem::Cipher;
       using RNG = typename EncryptionSystem::RNG;
 
+      // The client's polynomial at every element of the set, each value
+      // scaled by a random mask and shifted by the element, which the
+      // client finds again where the polynomial vanishes. With both sets
+      // large enough the values come from a remainder tree over the
+      // elements, from Horner's scheme per element otherwise.
       std::set<Cipher> evaluate(
           Polynomial<Cipher> const& fromClient, RNG rng) const {
+        auto const values = evaluateAll(fromClient,
+            detail::HasRemainderTree<RingType, Cipher>{});
+
         std::set<Cipher> result;
+        auto value = values.cbegin();
         for (auto const localElem : privateSet_) {
           auto const c = RingType{localElem};
-          auto const evaluated = fromClient(localElem);
-          result.insert(evaluated * rng() + c);
+          result.insert(*value++ * rng() + c);
         }
 
         return result;
       }
+
+    private:
+      std::vector<Cipher> evaluateAll(Polynomial<Cipher> const& fromClient,
+          std::false_type /* remainder tree */) const {
+        std::vector<Cipher> values;
+        for (auto const localElem : privateSet_)
+          values.push_back(fromClient(localElem));
+        return values;
+      }
+
+      std::vector<Cipher> evaluateAll(Polynomial<Cipher> const& fromClient,
+          std::true_type /* remainder tree */) const {
+        auto const threshold = CryptoCom::detail::RemainderTreeThreshold;
+        if (privateSet_.size() < threshold || fromClient.size() < threshold)
+          return evaluateAll(fromClient, std::false_type{});
+
+        RemainderTree<typename RingType::Traits, InputType> const tree(
+            privateSet_.cbegin(), privateSet_.cend());
+        return tree.evaluate(fromClient);
+      }
     };
   } // namespace ObliviousEvaluation
 } // namespace CryptoCom
@@ -1,18 +1,168 @@
 #pragma once
 
+#include <CryptoCom/LazyAccumulator.hpp>
+#include <CryptoCom/NumberTheoreticTransform.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <algorithm>
+#include <cstddef>
 #include <initializer_list>
 #include <iterator>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace CryptoCom {
+  namespace detail {
+
+    // Operands shorter than this are multiplied by the schoolbook method,
+    // which over word sized rings sums every coefficient of the product
+    // lazily and beats splitting them any further.
+    constexpr std::size_t PolynomialKaratsubaThreshold = 64;
+
+
+    // Karatsuba needs to subtract coefficients, which ciphers can't.
+    template <typename CoefficientType, typename = void>
+    struct HasSubtraction : std::false_type {};
+
+    template <typename CoefficientType>
+    struct HasSubtraction<CoefficientType,
+        VoidType<decltype(std::declval<CoefficientType const&>() -
+                          std::declval<CoefficientType const&>())>>
+        : std::true_type {};
+
+
+    // out[0, n + m - 1) = a[0, n) * b[0, m), each coefficient of the
+    // product summed up on its own so that over word sized rings the
+    // accumulator reduces it only once. An empty operand makes all of them
+    // zero.
+    template <typename CoefficientType>
+    void SchoolbookProduct(CoefficientType const* a, std::size_t const n,
+        CoefficientType const* b, std::size_t const m, CoefficientType* out) {
+      if (n == 0 || m == 0) {
+        std::fill(out, out + (n + m == 0 ? 0 : n + m - 1), CoefficientType{});
+        return;
+      }
+      for (std::size_t k = 0; k < n + m - 1; k++) {
+        LazyAccumulator<CoefficientType> sum;
+        auto const last = std::min(k, n - 1);
+        for (std::size_t i = k < m ? 0 : k - m + 1; i <= last; i++)
+          sum.add(a[i], b[k - i]);
+        out[k] = sum.value();
+      }
+    }
+
+
+    template <typename CoefficientType>
+    void PolynomialProduct(CoefficientType const* a, std::size_t n,
+        CoefficientType const* b, std::size_t m, CoefficientType* out);
+
+    // Karatsuba's method for operands of n coefficients: with a = a0 +
+    // a1 x^h and b = b0 + b1 x^h, the product is a0 b0 + ((a0 + a1)(b0 +
+    // b1) - a0 b0 - a1 b1) x^h + a1 b1 x^2h, three products of half the
+    // size instead of four, O(n^1.58) in all.
+    template <typename CoefficientType>
+    void KaratsubaProduct(CoefficientType const* a, CoefficientType const* b,
+        std::size_t const n, CoefficientType* out) {
+      auto const h = n / 2;
+      auto const high = n - h;
+
+      std::vector<CoefficientType> low(2 * h - 1), top(2 * high - 1),
+          middle(2 * high - 1), aSum(a + h, a + n), bSum(b + h, b + n);
+      for (std::size_t i = 0; i < h; i++) {
+        aSum[i] = aSum[i] + a[i];
+        bSum[i] = bSum[i] + b[i];
+      }
+      PolynomialProduct(a, h, b, h, low.data());
+      PolynomialProduct(a + h, high, b + h, high, top.data());
+      PolynomialProduct(aSum.data(), high, bSum.data(), high, middle.data());
+
+      std::fill(out, out + 2 * n - 1, CoefficientType{});
+      for (std::size_t k = 0; k < low.size(); k++) {
+        out[k] = low[k];
+        middle[k] = middle[k] - low[k];
+      }
+      for (std::size_t k = 0; k < top.size(); k++) {
+        out[2 * h + k] = top[k];
+        middle[k] = middle[k] - top[k];
+      }
+      for (std::size_t k = 0; k < middle.size(); k++)
+        out[h + k] = out[h + k] + middle[k];
+    }
+
+
+    // out[0, n + m - 1) = a[0, n) * b[0, m) by number-theoretic transforms
+    // where the coefficients allow for them and the operands are long
+    // enough, otherwise by Karatsuba's method for operands of the same
+    // length beyond the threshold. A longer operand is cut into pieces of
+    // the length of the shorter one, which are multiplied on their own and
+    // added up at their offsets.
+    template <typename CoefficientType>
+    void PolynomialProduct(CoefficientType const* a, std::size_t n,
+        CoefficientType const* b, std::size_t m, CoefficientType* out) {
+      if (TransformMultiplication<CoefficientType>::Multiply(a, n, b, m, out))
+        return;
+      if (std::min(n, m) < PolynomialKaratsubaThreshold) {
+        SchoolbookProduct(a, n, b, m, out);
+        return;
+      }
+      if (n == m) {
+        KaratsubaProduct(a, b, n, out);
+        return;
+      }
+      if (n < m) {
+        std::swap(a, b);
+        std::swap(n, m);
+      }
+
+      std::fill(out, out + n + m - 1, CoefficientType{});
+      std::vector<CoefficientType> piece(2 * m - 1);
+      for (std::size_t offset = 0; offset < n; offset += m) {
+        auto const length = std::min(m, n - offset);
+        PolynomialProduct(a + offset, length, b, m, piece.data());
+        for (std::size_t k = 0; k < length + m - 1; k++)
+          out[offset + k] = out[offset + k] + piece[k];
+      }
+    }
+
+  } // namespace detail
+
 
   template <typename CoefficientType>
   class Polynomial {
+    using Transform = typename detail::TransformOf<CoefficientType>::type;
+
+    // Products over rings with a number-theoretic transform of their own
+    // also keep their values at the roots of unity of some order 2^k, in
+    // the order Transform::Forward leaves them, so that multiplying them
+    // again reuses or doubles those values instead of transforming anew.
+    // The values are set when the product is made and dropped once the
+    // coefficients are written to. Copies and the result of fromRoots leave
+    // them behind, so they live only along a chain of products; const
+    // members never touch either.
     std::vector<CoefficientType> coefficients_;
+    std::vector<CoefficientType> values_;
+
+    Polynomial(std::vector<CoefficientType>&& coeffs,
+        std::vector<CoefficientType>&& values)
+        : coefficients_(std::move(coeffs)), values_(std::move(values)) {}
 
   public:
     Polynomial(std::initializer_list<CoefficientType> l) : coefficients_(l) {}
-    Polynomial(std::vector<CoefficientType>&& coeffs) : coefficients_(coeffs) {}
+    Polynomial(std::vector<CoefficientType>&& coeffs)
+        : coefficients_(std::move(coeffs)) {}
+
+    Polynomial(Polynomial<CoefficientType> const& other)
+        : coefficients_(other.coefficients_) {}
+    Polynomial(Polynomial<CoefficientType>&&) = default;
+
+    Polynomial<CoefficientType>& operator=(
+        Polynomial<CoefficientType> const& other) {
+      coefficients_ = other.coefficients_;
+      values_ = std::vector<CoefficientType>{};
+      return *this;
+    }
+    Polynomial<CoefficientType>& operator=(
+        Polynomial<CoefficientType>&&) = default;
 
     template <typename VariableType>
     CoefficientType operator()(VariableType const& x) const {
@@ -25,27 +175,46 @@ namespace CryptoCom {
     }
 
 
+    // Pointwise in the transform's domain for large operands over rings
+    // with a number-theoretic transform. Otherwise number-theoretic
+    // transforms by the Chinese remainder theorem or Karatsuba's method
+    // for large operands over coefficients which can be subtracted, the
+    // schoolbook method otherwise.
     Polynomial<CoefficientType> operator*(
         Polynomial<CoefficientType> const& other) const {
-      std::vector<CoefficientType> res;
-      res.resize(coefficients_.size() + other.coefficients_.size() - 1);
-      for (size_t i = 0; i < coefficients_.size(); i++) {
-        for (size_t j = 0; j < other.coefficients_.size(); j++) {
-          res[i + j] += coefficients_[i] * other.coefficients_[j];
-        }
+      auto const n = coefficients_.size();
+      auto const m = other.coefficients_.size();
+      auto const size = n + m == 0 ? 0 : n + m - 1;
+      if (std::min(n, m) >= detail::TransformThreshold &&
+          size <= Transform::MaxSize()) {
+        std::size_t length = 1;
+        while (length < size)
+          length *= 2;
+        auto values = valuesAt(length);
+        auto const otherValues = other.valuesAt(length);
+        for (std::size_t idx = 0; idx < length; idx++)
+          values[idx] = values[idx] * otherValues[idx];
+        std::vector<CoefficientType> res(values);
+        Transform::Inverse(res.data(), length);
+        res.erase(res.begin() + size, res.end());
+        return {std::move(res), std::move(values)};
       }
 
+      std::vector<CoefficientType> res(size);
+      multiply(other, res.data(), detail::HasSubtraction<CoefficientType>{});
       return {std::move(res)};
     }
 
 
-    CoefficientType& operator[](size_t idx) { return coefficients_[idx]; }
+    CoefficientType& operator[](size_t idx) {
+      return mutableCoefficients()[idx];
+    }
     CoefficientType operator[](size_t idx) const { return coefficients_[idx]; }
     size_t size() const { return coefficients_.size(); }
 
 
     typename std::vector<CoefficientType>::iterator begin() {
-      return coefficients_.begin();
+      return mutableCoefficients().begin();
     }
 
     typename std::vector<CoefficientType>::const_iterator cbegin() const {
@@ -53,7 +222,7 @@ namespace CryptoCom {
     }
 
     typename std::vector<CoefficientType>::iterator end() {
-      return coefficients_.end();
+      return mutableCoefficients().end();
     }
 
     typename std::vector<CoefficientType>::const_iterator cend() const {
@@ -69,23 +238,80 @@ namespace CryptoCom {
     }
 
 
+    // The product of the linear factors x - root over a balanced subproduct
+    // tree: neighbouring factors are multiplied pairwise, then neighbouring
+    // products, and so on up to the root of the tree. Every level costs
+    // about as much as a single product of the full degree, so with a
+    // multiplication in M(n) the polynomial takes O(M(n) log n) rather than
+    // the n products of growing degree of one factor at a time.
     template <typename RootIt>
     static Polynomial<CoefficientType> fromRoots(RootIt first,
         RootIt last,
         CoefficientType const minusOne = -1,
         CoefficientType const plusOne = 1) {
-      Polynomial<CoefficientType> polynomial{minusOne * (*first), plusOne};
-      for (auto current = std::next(first); current != last; ++current) {
-        auto const root = *current;
-        polynomial =
-            polynomial * Polynomial<CoefficientType>{minusOne * root, plusOne};
+      std::vector<Polynomial<CoefficientType>> level;
+      for (; first != last; ++first)
+        level.push_back({minusOne * (*first), plusOne});
+      if (level.empty())
+        return {plusOne};
+
+      while (level.size() > 1) {
+        std::vector<Polynomial<CoefficientType>> next;
+        next.reserve((level.size() + 1) / 2);
+        for (size_t idx = 0; idx + 1 < level.size(); idx += 2)
+          next.push_back(level[idx] * level[idx + 1]);
+        if (level.size() % 2 == 1)
+          next.push_back(std::move(level.back()));
+        level = std::move(next);
       }
 
-      return polynomial;
+      level.front().values_ = std::vector<CoefficientType>{};
+      return std::move(level.front());
     }
 
     friend std::ostream& operator<<(
         std::ostream&, Polynomial<CoefficientType> const&);
+
+  private:
+    // Coefficients about to be written to, which the values no longer
+    // follow.
+    std::vector<CoefficientType>& mutableCoefficients() {
+      values_.clear();
+      return coefficients_;
+    }
+
+    // The values at the 2^k = length roots of unity, a copy of the kept
+    // ones, those doubled from the ones at half as many, or else
+    // transformed anew.
+    std::vector<CoefficientType> valuesAt(std::size_t const length) const {
+      if (values_.size() == length)
+        return values_;
+
+      std::vector<CoefficientType> values(values_);
+      if (2 * values_.size() == length) {
+        values.resize(length);
+        Transform::Extend(coefficients_.data(), coefficients_.size(),
+            values.data(), length / 2);
+        return values;
+      }
+
+      values.assign(coefficients_.begin(), coefficients_.end());
+      values.resize(length, CoefficientType{});
+      Transform::Forward(values.data(), length);
+      return values;
+    }
+
+    void multiply(Polynomial<CoefficientType> const& other,
+        CoefficientType* out, std::true_type /* subtraction */) const {
+      detail::PolynomialProduct(coefficients_.data(), coefficients_.size(),
+          other.coefficients_.data(), other.coefficients_.size(), out);
+    }
+
+    void multiply(Polynomial<CoefficientType> const& other,
+        CoefficientType* out, std::false_type /* subtraction */) const {
+      detail::SchoolbookProduct(coefficients_.data(), coefficients_.size(),
+          other.coefficients_.data(), other.coefficients_.size(), out);
+    }
   };
 
 } // namespace CryptoCom
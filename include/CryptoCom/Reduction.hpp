@@ -0,0 +1,282 @@
+#pragma once
+
+#include <CryptoCom/IntegerTraits.hpp>
+#include <type_traits>
+
+namespace CryptoCom {
+
+  // Tags selecting how a CyclicRing keeps and reduces its elements. A ring
+  // picks one by declaring `using Reduction = ...;` in its traits, when no
+  // such declaration is present the ring falls back to SpecialFormReduction
+  // for large orders just below a power of two and to DivisionReduction
+  // otherwise.
+  struct DivisionReduction {};
+  struct MontgomeryReduction {};
+  struct BarrettReduction {};
+  struct ResidueNumberSystem {};
+  struct DynamicReduction {};
+  struct SpecialFormReduction {};
+
+
+  // Reduction kernels are specialised on the tag. Each kernel defines the
+  // Representation stored in the ring, conversions from and to canonical
+  // integers and the modular arithmetic over that representation.
+  template <typename Tag, typename RingTraits>
+  struct ReductionKernel;
+
+
+  namespace detail {
+    template <typename...>
+    using VoidType = void;
+
+    // Whether order = 2^k - c for a k bit order and an offset c below
+    // 2^(k/2) which fits a 64 bit word, as Mersenne numbers 2^k - 1,
+    // pseudo-Mersenne numbers like 2^255 - 19 and Solinas numbers like
+    // 2^62 - 2^16 + 1 are.
+    template <typename Unsigned>
+    constexpr Unsigned SpecialFormOffset(Unsigned const order) {
+      return Unsigned(Unsigned(Unsigned(1) << BitLength(order)) - order);
+    }
+
+    template <typename Unsigned>
+    constexpr bool IsSpecialForm(Unsigned const order) {
+      auto const bits = BitLength(order);
+      if (bits < 2 || bits >= Digits<Unsigned>::value)
+        return false;
+      auto const offsetBits = BitLength(SpecialFormOffset(order));
+      return offsetBits <= bits / 2 && offsetBits <= 64;
+    }
+
+
+    // Rings of at least 2^60 elements whose order is 2^k - c for an
+    // offset c below 2^32, and which can hold their squares, reduce with
+    // shifts and adds by default, all others by division. Smaller orders
+    // and larger offsets gain little over division and opt in explicitly.
+    template <typename RingTraits>
+    constexpr bool PrefersSpecialForm() {
+      using Unsigned =
+          typename UnsignedOf<typename RingTraits::PrimaryType>::type;
+      return IsSpecialForm(Unsigned(RingTraits::Order)) &&
+             BitLength(Unsigned(RingTraits::Order)) > 60 &&
+             BitLength(SpecialFormOffset(Unsigned(RingTraits::Order))) <= 32 &&
+             2 * BitLength(Unsigned(RingTraits::Order)) <=
+                 Digits<typename UnsignedOf<
+                     typename RingTraits::EscalationType>::type>::value;
+    }
+
+
+    template <typename RingTraits, typename = void>
+    struct ReductionTagOf {
+      using type = typename std::conditional<PrefersSpecialForm<RingTraits>(),
+          SpecialFormReduction, DivisionReduction>::type;
+    };
+
+    template <typename RingTraits>
+    struct ReductionTagOf<RingTraits,
+        VoidType<typename RingTraits::Reduction>> {
+      using type = typename RingTraits::Reduction;
+    };
+
+
+    // Traits may declare `static constexpr bool PrimeOrder = true;` to have
+    // elements inverted by Fermat's little theorem rather than by the
+    // extended Euclidean algorithm.
+    template <typename RingTraits, typename = void>
+    struct HasPrimeOrder : std::false_type {};
+
+    template <typename RingTraits>
+    struct HasPrimeOrder<RingTraits, VoidType<decltype(RingTraits::PrimeOrder)>>
+        : std::integral_constant<bool, RingTraits::PrimeOrder> {};
+
+
+    // Whether the order is a word of at most 64 bits known at compile time,
+    // so that exponents derived from it make compile time addition chains.
+    template <typename RingTraits>
+    struct HasConstantWordOrder
+        : std::integral_constant<bool,
+              std::is_integral<typename RingTraits::PrimaryType>::value &&
+                  !std::is_same<typename ReductionTagOf<RingTraits>::type,
+                      DynamicReduction>::value> {};
+
+
+    // Traits of a Schnorr group declare `static constexpr PrimaryType
+    // SubgroupOrder = q;`, a prime q dividing Order - 1, with a Generator
+    // of order q. Keys, random terms and masks are powers of the generator
+    // and their exponents only matter modulo q, which may be much shorter
+    // than the order: a 256 bit q in a 3072 bit group.
+    template <typename RingTraits, typename = void>
+    struct HasSubgroupOrder : std::false_type {};
+
+    template <typename RingTraits>
+    struct HasSubgroupOrder<RingTraits,
+        VoidType<decltype(RingTraits::SubgroupOrder)>> : std::true_type {};
+
+
+    // The modulus of the exponents: the SubgroupOrder of a Schnorr group,
+    // the order itself otherwise.
+    template <typename RingTraits>
+    constexpr typename std::enable_if<HasSubgroupOrder<RingTraits>::value,
+        typename RingTraits::PrimaryType>::type
+    ExponentModulus() {
+      static_assert((RingTraits::Order - 1) % RingTraits::SubgroupOrder == 0,
+          "the SubgroupOrder has to divide Order - 1");
+      return RingTraits::SubgroupOrder;
+    }
+
+    template <typename RingTraits>
+    constexpr typename std::enable_if<!HasSubgroupOrder<RingTraits>::value,
+        typename RingTraits::PrimaryType>::type
+    ExponentModulus() {
+      return RingTraits::Order;
+    }
+
+
+    // Whether every residue modulo order fits into the StorageType.
+    template <typename StorageType, typename PrimaryType>
+    constexpr typename std::enable_if<
+        std::is_same<StorageType, PrimaryType>::value, bool>::type
+    StorageHolds(PrimaryType const&) {
+      return true;
+    }
+
+    template <typename StorageType, typename PrimaryType>
+    constexpr typename std::enable_if<
+        !std::is_same<StorageType, PrimaryType>::value, bool>::type
+    StorageHolds(PrimaryType const order) {
+      using Unsigned = typename UnsignedOf<PrimaryType>::type;
+      return order > 0 &&
+             Unsigned(order - 1) <= Unsigned(MaxOf<StorageType>());
+    }
+
+
+    // Orders known at compile time are checked against the StorageType as
+    // the ring is instantiated.
+    template <typename RingTraits, typename StorageType,
+        typename = typename ReductionTagOf<RingTraits>::type>
+    struct StorageHoldsOrder
+        : std::integral_constant<bool,
+              StorageHolds<StorageType>(RingTraits::Order)> {};
+
+
+    // Traits may declare `using StorageType = ...;`, an integer narrower
+    // than the PrimaryType such as uint32_t for orders below 2^32. Elements
+    // are then kept and copied in the StorageType, which halves the memory
+    // of polynomials and ciphers over such rings, while the arithmetic
+    // widens to the kernel's representation for every operation.
+    template <typename RingTraits, typename Representation, typename = void>
+    struct StorageOf {
+      using type = Representation;
+    };
+
+    template <typename RingTraits, typename Representation>
+    struct StorageOf<RingTraits, Representation,
+        VoidType<typename RingTraits::StorageType>> {
+      using type = typename RingTraits::StorageType;
+
+      static_assert(std::is_integral<Representation>::value &&
+                        std::is_integral<type>::value &&
+                        sizeof(type) <= sizeof(Representation),
+          "the StorageType has to be an integer no wider than the "
+          "representation of a word sized ring");
+      static_assert(StorageHoldsOrder<RingTraits, type>::value,
+          "every residue modulo the order has to fit into the StorageType");
+    };
+
+
+    // Addition, subtraction and negation are shared by every representation
+    // which keeps its residues in the range [0, Order). Operands are already
+    // reduced, so a single conditional correction replaces the division.
+    template <typename RingTraits>
+    struct ModularAddition {
+      using Representation = typename RingTraits::PrimaryType;
+      using Unsigned = typename UnsignedOf<Representation>::type;
+
+      static_assert(Unsigned(RingTraits::Order) - 1 <= MaxOf<Unsigned>() / 2,
+          "the sum of two residues has to fit into the PrimaryType");
+
+      // Reduces any integer, negative ones included, into [0, Order).
+      static constexpr Representation Canonical(Representation const value) {
+        auto const remainder = Representation(value % RingTraits::Order);
+        return remainder < 0 ? Representation(remainder + RingTraits::Order)
+                             : remainder;
+      }
+
+      static constexpr Representation Add(
+          Representation const lhs, Representation const rhs) {
+        auto const sum = Unsigned(Unsigned(lhs) + Unsigned(rhs));
+        return Representation(sum >= Unsigned(RingTraits::Order)
+                                  ? Unsigned(sum - RingTraits::Order)
+                                  : sum);
+      }
+
+      static constexpr Representation Subtract(
+          Representation const lhs, Representation const rhs) {
+        return lhs >= rhs ? Representation(lhs - rhs)
+                          : Representation(lhs + (RingTraits::Order - rhs));
+      }
+
+      static constexpr Representation Negate(Representation const value) {
+        return value == 0 ? value : Representation(RingTraits::Order - value);
+      }
+
+      // Residues below Order are unique, so they compare as they are.
+      static constexpr bool Equal(
+          Representation const lhs, Representation const rhs) {
+        return lhs == rhs;
+      }
+
+      static constexpr bool Less(
+          Representation const lhs, Representation const rhs) {
+        return lhs < rhs;
+      }
+    };
+  } // namespace detail
+
+
+  template <typename RingTraits>
+  using ReductionOf =
+      ReductionKernel<typename detail::ReductionTagOf<RingTraits>::type,
+          RingTraits>;
+
+
+  template <typename RingTraits>
+  struct ReductionKernel<DivisionReduction, RingTraits>
+      : detail::ModularAddition<RingTraits> {
+    using PrimaryType = typename RingTraits::PrimaryType;
+    using EscalationType = typename RingTraits::EscalationType;
+    using Representation = PrimaryType;
+
+    static_assert(detail::SquareFits<EscalationType>(RingTraits::Order),
+        "the EscalationType has to hold the square of the order");
+
+    static constexpr Representation FromInteger(PrimaryType const value) {
+      return detail::ModularAddition<RingTraits>::Canonical(value);
+    }
+
+    static constexpr PrimaryType ToInteger(Representation const value) {
+      return value;
+    }
+
+    static constexpr Representation Multiply(
+        Representation const lhs, Representation const rhs) {
+      return static_cast<PrimaryType>(
+          (EscalationType(lhs) * rhs) % RingTraits::Order);
+    }
+
+    static constexpr Representation Square(Representation const value) {
+      return Multiply(value, value);
+    }
+
+    // Sums of products for LazyAccumulator, reduced by a single division.
+    using DoubleWord = typename detail::UnsignedOf<EscalationType>::type;
+
+    static constexpr DoubleWord ProductBound() {
+      return detail::MaxOf<DoubleWord>();
+    }
+
+    static constexpr Representation ReduceProduct(DoubleWord const value) {
+      return Representation(value % DoubleWord(RingTraits::Order));
+    }
+  };
+
+} // namespace CryptoCom
@@ -0,0 +1,317 @@
+#pragma once
+
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/MultiExp.hpp>
+#include <CryptoCom/Polynomial.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+namespace CryptoCom {
+  namespace detail {
+
+    // Exponents of the generator, which exponential ElGamal encrypts, are
+    // integers modulo its order: the SubgroupOrder of a Schnorr group, and
+    // Order - 1 of a prime order, which every order of an element divides.
+    // Other orders give no such modulus short of factoring them.
+    template <typename RingTraits>
+    struct HasExponentOrder
+        : std::integral_constant<bool,
+              HasSubgroupOrder<RingTraits>::value ||
+                  HasPrimeOrder<RingTraits>::value> {};
+
+    template <typename RingTraits>
+    struct ExponentTraits {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using EscalationType = typename RingTraits::EscalationType;
+      using CoefficientType = typename RingTraits::CoefficientType;
+
+      static constexpr PrimaryType Order{HasSubgroupOrder<RingTraits>::value
+                                             ? ExponentModulus<RingTraits>()
+                                             : RingTraits::Order - 1};
+      static constexpr PrimaryType Generator{1};
+      static constexpr PrimaryType AdditiveIdentity{0};
+      static constexpr PrimaryType MultiplicativeIdentity{1};
+    };
+
+    template <typename RingTraits>
+    constexpr typename RingTraits::PrimaryType
+        ExponentTraits<RingTraits>::Order;
+
+
+    // Ciphers times fewer plain texts than this are multiplied term by
+    // term, every coefficient of the product a multi-exponentiation of the
+    // ciphers. Beyond it Karatsuba's method trades the costly scaling of a
+    // cipher for a few additions and subtractions.
+    constexpr std::size_t ScaledKaratsubaThreshold = 64;
+
+
+    template <typename Cipher, typename Scalar>
+    void ScaledProduct(Cipher const* a, std::size_t n, Scalar const* b,
+        std::size_t m, Cipher* out);
+
+    template <typename Cipher, typename Scalar>
+    void ScaledSchoolbookProduct(Cipher const* a, std::size_t const n,
+        Scalar const* b, std::size_t const m, Cipher* out) {
+      std::vector<Cipher> bases;
+      std::vector<decltype(b->ordinalIndex())> exponents;
+      for (std::size_t k = 0; k < n + m - 1; k++) {
+        bases.clear();
+        exponents.clear();
+        auto const last = std::min(k, n - 1);
+        for (std::size_t i = k < m ? 0 : k - m + 1; i <= last; i++) {
+          bases.push_back(a[i]);
+          exponents.push_back(b[k - i].ordinalIndex());
+        }
+        out[k] = MultiExp(bases, exponents);
+      }
+    }
+
+    // Karatsuba's method with ciphers on one side and plain texts on the
+    // other: the sums of the halves are added as ciphers and as plain texts
+    // respectively. The outer products are added up before they are
+    // subtracted from the middle one, as a cipher subtraction inverts.
+    template <typename Cipher, typename Scalar>
+    void ScaledKaratsubaProduct(Cipher const* a, Scalar const* b,
+        std::size_t const n, Cipher* out) {
+      auto const h = n / 2;
+      auto const high = n - h;
+
+      std::vector<Cipher> low(2 * h - 1, Cipher::Zero()),
+          top(2 * high - 1, Cipher::Zero()),
+          middle(2 * high - 1, Cipher::Zero()), aSum(a + h, a + n);
+      std::vector<Scalar> bSum(b + h, b + n);
+      for (std::size_t i = 0; i < h; i++) {
+        aSum[i] = aSum[i] + a[i];
+        bSum[i] = bSum[i] + b[i];
+      }
+      ScaledProduct(a, h, b, h, low.data());
+      ScaledProduct(a + h, high, b + h, high, top.data());
+      ScaledProduct(aSum.data(), high, bSum.data(), high, middle.data());
+
+      std::fill(out, out + 2 * n - 1, Cipher::Zero());
+      std::copy(low.begin(), low.end(), out);
+      std::copy(top.begin(), top.end(), out + 2 * h);
+      for (std::size_t k = 0; k < middle.size(); k++) {
+        auto const outer = k < low.size() ? low[k] + top[k] : top[k];
+        out[h + k] = out[h + k] + (middle[k] - outer);
+      }
+    }
+
+    // out[0, n + m - 1) = a[0, n) * b[0, m) for ciphers a and plain texts
+    // b, the exponents the ciphers are scaled by.
+    template <typename Cipher, typename Scalar>
+    void ScaledProduct(Cipher const* a, std::size_t const n, Scalar const* b,
+        std::size_t const m, Cipher* out) {
+      if (std::min(n, m) < ScaledKaratsubaThreshold) {
+        ScaledSchoolbookProduct(a, n, b, m, out);
+        return;
+      }
+      if (n == m) {
+        ScaledKaratsubaProduct(a, b, n, out);
+        return;
+      }
+
+      std::fill(out, out + n + m - 1, Cipher::Zero());
+      auto const piece = std::min(n, m);
+      std::vector<Cipher> partial(2 * piece - 1, Cipher::Zero());
+      for (std::size_t offset = 0; offset < std::max(n, m); offset += piece) {
+        auto const length = std::min(piece, std::max(n, m) - offset);
+        if (n > m)
+          ScaledProduct(a + offset, length, b, m, partial.data());
+        else
+          ScaledProduct(a, n, b + offset, length, partial.data());
+        for (std::size_t k = 0; k < length + piece - 1; k++)
+          out[offset + k] = out[offset + k] + partial[k];
+      }
+    }
+
+
+    // g with f g = 1 modulo x^length for f(0) = 1, by Newton's iteration
+    // g <- g (2 - f g), which doubles the precision of g every step.
+    template <typename Scalar>
+    std::vector<Scalar> InverseSeries(
+        std::vector<Scalar> const& f, std::size_t const length) {
+      std::vector<Scalar> g{Scalar::One()};
+      for (std::size_t precision = 1; precision < length;) {
+        precision = std::min(2 * precision, length);
+        auto const used = std::min(f.size(), precision);
+        std::vector<Scalar> error(used + g.size() - 1);
+        PolynomialProduct(f.data(), used, g.data(), g.size(), error.data());
+        error.resize(precision, Scalar::Zero());
+        for (auto& coefficient : error)
+          coefficient = -coefficient;
+        error[0] = error[0] + Scalar::One() + Scalar::One();
+
+        std::vector<Scalar> next(g.size() + precision - 1);
+        PolynomialProduct(
+            g.data(), g.size(), error.data(), precision, next.data());
+        next.resize(precision);
+        g = std::move(next);
+      }
+      return g;
+    }
+
+
+    // p[0, k + l) modulo a monic divisor d of degree k >= l by the reversed
+    // quotient: rev(q) = rev(p) rev(d)^-1 modulo x^l, after which only the
+    // k lowest coefficients of p + (-d) q are left to compute. Both steps
+    // are products of ciphers and plain texts; `negated` holds the k lower
+    // coefficients of -d and `inverse` the l of rev(d)^-1.
+    template <typename Cipher, typename Scalar>
+    std::vector<Cipher> ScaledReduction(std::vector<Cipher> const& p,
+        std::vector<Scalar> const& negated,
+        std::vector<Scalar> const& inverse) {
+      auto const degree = negated.size();
+      auto const length = p.size() - degree;
+
+      std::vector<Cipher> quotient(2 * length - 1, Cipher::Zero());
+      std::vector<Cipher> const top(
+          p.rbegin(), p.rbegin() + std::ptrdiff_t(length));
+      ScaledProduct(
+          top.data(), length, inverse.data(), length, quotient.data());
+      quotient.erase(quotient.begin() + std::ptrdiff_t(length), quotient.end());
+      std::reverse(quotient.begin(), quotient.end());
+
+      std::vector<Cipher> product(length + degree - 1, Cipher::Zero());
+      ScaledProduct(
+          quotient.data(), length, negated.data(), degree, product.data());
+
+      std::vector<Cipher> remainder(p.begin(), p.begin() + degree);
+      for (std::size_t k = 0; k < degree; k++)
+        remainder[k] = remainder[k] + product[k];
+      return remainder;
+    }
+
+    // p modulo the monic divisor d of degree k, k coefficients of p at a
+    // time from the top, so that a long p takes deg p / k reductions of
+    // the size of d rather than one of the size of p.
+    template <typename Cipher, typename Scalar>
+    std::vector<Cipher> ScaledRemainder(
+        std::vector<Cipher> const& p, std::vector<Scalar> const& d) {
+      auto const degree = d.size() - 1;
+      if (p.size() <= degree)
+        return p;
+
+      auto const longest = std::min(p.size() - degree, degree);
+      std::vector<Scalar> const reversed(
+          d.rbegin(), d.rbegin() + std::ptrdiff_t(longest));
+      auto const inverse = InverseSeries(reversed, longest);
+      std::vector<Scalar> negated(d.begin(), d.begin() + degree);
+      for (auto& coefficient : negated)
+        coefficient = -coefficient;
+
+      auto start = p.size() - degree;
+      std::vector<Cipher> remainder(p.begin() + std::ptrdiff_t(start), p.end());
+      while (start > 0) {
+        auto const length = std::min(start, degree);
+        start -= length;
+        std::vector<Cipher> dividend(p.begin() + std::ptrdiff_t(start),
+            p.begin() + std::ptrdiff_t(start + length));
+        dividend.insert(dividend.end(), remainder.begin(), remainder.end());
+        remainder = ScaledReduction(dividend, negated,
+            std::vector<Scalar>(inverse.begin(), inverse.begin() + length));
+      }
+      return remainder;
+    }
+
+
+    // Nodes at this level of the tree, of 2^level points at most, evaluate
+    // their remainders point by point.
+    constexpr int RemainderTreeLeafLevel = 4;
+
+    // Servers with fewer elements, or clients with fewer, are evaluated at
+    // by Horner's scheme, whose small scalars win out up to about here.
+    constexpr std::size_t RemainderTreeThreshold = 64;
+
+  } // namespace detail
+
+
+  // Evaluates polynomials of exponential ElGamal ciphers at many plain
+  // text points at once. The points are the roots of a subproduct tree:
+  // its leaves x - x_i, and every node the product of its children. The
+  // polynomial is reduced modulo the root, the remainder modulo the
+  // children of the root, and so on down the tree, so that the remainders
+  // shrink with the nodes until they are evaluated by Horner's scheme at
+  // the few points of a node near the leaves. With fast products of
+  // ciphers and plain texts that takes O(M(n) log n) operations on ciphers
+  // rather than one Horner's scheme, of m operations, for every point.
+  template <typename RingTraits, typename Point>
+  class RemainderTree {
+    static_assert(detail::HasExponentOrder<RingTraits>::value,
+        "the remainder tree needs a prime order or a SubgroupOrder");
+
+    using Ring = CyclicRing<RingTraits>;
+    using Scalar = CyclicRing<detail::ExponentTraits<RingTraits>>;
+    using Primary = typename RingTraits::PrimaryType;
+
+    std::vector<Point> points_;
+    std::vector<std::vector<std::vector<Scalar>>> levels_;
+
+  public:
+    template <typename InputIt>
+    RemainderTree(InputIt first, InputIt last) : points_(first, last) {
+      std::vector<std::vector<Scalar>> level;
+      for (auto const& point : points_) {
+        auto const exponent = Ring{point}.exponent() %
+                              detail::ExponentTraits<RingTraits>::Order;
+        level.push_back({-Scalar{Primary(exponent)}, Scalar::One()});
+      }
+      levels_.push_back(std::move(level));
+
+      while (levels_.back().size() > 1) {
+        auto const& below = levels_.back();
+        std::vector<std::vector<Scalar>> next;
+        for (std::size_t idx = 0; idx + 1 < below.size(); idx += 2) {
+          auto const& lhs = below[idx];
+          auto const& rhs = below[idx + 1];
+          std::vector<Scalar> product(lhs.size() + rhs.size() - 1);
+          detail::PolynomialProduct(
+              lhs.data(), lhs.size(), rhs.data(), rhs.size(), product.data());
+          next.push_back(std::move(product));
+        }
+        if (below.size() % 2 == 1)
+          next.push_back(below.back());
+        levels_.push_back(std::move(next));
+      }
+    }
+
+    // The values of the polynomial at the points, in their order.
+    template <typename Cipher>
+    std::vector<Cipher> evaluate(Polynomial<Cipher> const& polynomial) const {
+      std::vector<Cipher> values;
+      if (points_.empty())
+        return values;
+
+      auto leafLevel = std::size_t(detail::RemainderTreeLeafLevel);
+      leafLevel = std::min(leafLevel, levels_.size() - 1);
+      std::vector<std::vector<Cipher>> remainders{
+          {polynomial.cbegin(), polynomial.cend()}};
+      if (levels_.size() - 1 > leafLevel) {
+        remainders.front() =
+            detail::ScaledRemainder(remainders.front(), levels_.back().front());
+      }
+      for (auto level = levels_.size() - 1; level > leafLevel; --level) {
+        auto const& below = levels_[level - 1];
+        std::vector<std::vector<Cipher>> next;
+        for (std::size_t idx = 0; idx < below.size(); ++idx) {
+          next.push_back(
+              detail::ScaledRemainder(remainders[idx / 2], below[idx]));
+        }
+        remainders = std::move(next);
+      }
+
+      auto const span = std::size_t(1) << leafLevel;
+      for (std::size_t idx = 0; idx < points_.size(); ++idx) {
+        Polynomial<Cipher> const remainder(
+            std::vector<Cipher>(remainders[idx / span]));
+        values.push_back(remainder(points_[idx]));
+      }
+      return values;
+    }
+  };
+
+} // namespace CryptoCom
@@ -0,0 +1,507 @@
+#pragma once
+
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Montgomery.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+namespace CryptoCom {
+
+  namespace detail {
+
+    // A residue lane is a prime modulus in (2^27, 2^28). Lane values are kept
+    // in 32 bit Montgomery form, x * 2^32 mod m, so a lane product is a
+    // single 32 by 32 bit multiplication followed by a REDC, the same few
+    // instructions for every lane, which the compiler can vectorize. The
+    // moduli are kept short so that 255 products of two residues add up in
+    // 64 bits without any reduction in between.
+    using Residue = std::uint32_t;
+
+    constexpr int ResidueBits = 32;
+    constexpr int LaneBits = 28;
+    constexpr std::size_t AccumulatedProducts = 255;
+
+
+    // a * b / 2^32 mod m for a, b below m.
+    constexpr Residue LaneMultiply(Residue const a, Residue const b,
+        Residue const modulus, Residue const negInverse) {
+      auto const t = std::uint64_t(a) * b;
+      auto const m = Residue(Residue(t) * negInverse);
+      auto const u =
+          Residue((t + std::uint64_t(m) * modulus) >> ResidueBits);
+      return u >= modulus ? u - modulus : u;
+    }
+
+    constexpr Residue LaneAdd(
+        Residue const a, Residue const b, Residue const modulus) {
+      return a + b >= modulus ? a + b - modulus : a + b;
+    }
+
+    constexpr Residue LaneSubtract(
+        Residue const a, Residue const b, Residue const modulus) {
+      return a >= b ? a - b : a + (modulus - b);
+    }
+
+
+    // Plain modular arithmetic on lane sized integers, only used while the
+    // constants of a residue number system are being set up.
+    inline Residue MultiplyModulo(
+        Residue const a, Residue const b, Residue const modulus) {
+      return Residue(std::uint64_t(a) * b % modulus);
+    }
+
+    inline Residue PowerModulo(
+        Residue base, Residue exponent, Residue const modulus) {
+      Residue result = 1 % modulus;
+      for (; exponent != 0; exponent >>= 1) {
+        if (exponent & 1)
+          result = MultiplyModulo(result, base, modulus);
+        base = MultiplyModulo(base, base, modulus);
+      }
+      return result;
+    }
+
+    // Miller-Rabin with the bases 2, 7 and 61 is deterministic below 2^32.
+    inline bool IsLanePrime(Residue const candidate) {
+      auto const odd = candidate - 1;
+      int twos = 0;
+      for (auto d = odd; d % 2 == 0; d /= 2)
+        ++twos;
+
+      for (Residue const witness : {2u, 7u, 61u}) {
+        auto x = PowerModulo(witness, odd >> twos, candidate);
+        if (x == 1 || x == odd)
+          continue;
+        for (int round = 1; round < twos && x != odd; ++round)
+          x = MultiplyModulo(x, x, candidate);
+        if (x != odd)
+          return false;
+      }
+      return true;
+    }
+
+    template <std::size_t Bits>
+    Residue ResidueOf(FixedUInt<Bits> const& value, Residue const modulus) {
+      UInt128 remainder = 0;
+      for (std::size_t idx = FixedUInt<Bits>::LimbCount; idx > 0; --idx)
+        remainder = ((remainder << 64) | value.data()[idx - 1]) % modulus;
+      return Residue(remainder);
+    }
+
+
+    // Lanes per base, such that the product of a base, at least 2^(27 k),
+    // exceeds (k + 2)^2 times any order of the given bit length.
+    constexpr std::size_t ResidueLaneCount(int const bits) {
+      std::size_t lanes = 1;
+      while ((LaneBits - 1) * int(lanes) < bits + 2 * BitLength(lanes + 2) + 1)
+        ++lanes;
+      return lanes;
+    }
+
+
+    // An element is held twice, modulo the primes of the base B and of the
+    // extension base B', and once more modulo 2^32, the redundant lane that
+    // makes the conversion from B' back to B exact.
+    template <std::size_t Lanes>
+    struct ResidueVector {
+      Residue base[Lanes];
+      Residue extension[Lanes];
+      Residue redundant;
+    };
+
+  } // namespace detail
+
+
+  // Residue number system (RNS) representation for large FixedUInt orders.
+  // An element x is stored as the residues of x * M mod N, where M is the
+  // product of the base B, and multiplied with the RNS variant of
+  // Montgomery multiplication (Bajard, Kawamura et al.):
+  //
+  //   s = a * b            lane-wise in B, B' and the redundant lane
+  //   q = -s / N mod M     lane-wise in B
+  //   q' = q + alpha M     approximate extension of q to B'
+  //   r = (s + q' N) / M   lane-wise in B'
+  //   r in B               exact extension (Shenoy-Kumaresan)
+  //
+  // Only the base extensions mix lanes, a k by k matrix-vector product of
+  // 64 bit multiply-adds; everything else is independent per lane. The
+  // result r is congruent to a * b / M but only bounded by (k + 2) N rather
+  // than reduced below N, hence comparisons go through the canonical integer
+  // and the additive operations finish with a multiplication by one to keep
+  // that bound.
+  template <typename RingTraits>
+  struct ReductionKernel<ResidueNumberSystem, RingTraits> {
+    using PrimaryType = typename RingTraits::PrimaryType;
+    using Residue = detail::Residue;
+
+    static_assert(detail::IsFixedInteger<PrimaryType>::value,
+        "the residue number system is meant for FixedUInt orders");
+
+    static constexpr std::size_t Lanes =
+        detail::ResidueLaneCount(detail::Digits<PrimaryType>::value);
+
+    using Representation = detail::ResidueVector<Lanes>;
+
+    // Wide enough for every partial sum of the CRT reconstruction from B'.
+    using Wide = FixedUInt<64 * ((detail::LaneBits * Lanes + 127) / 64)>;
+
+
+    struct Constants {
+      Residue moduli[Lanes];
+      Residue negInverses[Lanes];
+      Residue r[Lanes];
+      Residue rSquared[Lanes];
+      Residue extensionModuli[Lanes];
+      Residue extensionNegInverses[Lanes];
+      Residue extensionR[Lanes];
+      Residue extensionRSquared[Lanes];
+
+      // B to B': -N^-1 |M_i|^-1 mod m_i plainly, then |M_i| mod m'_j in
+      // Montgomery form and mod 2^32, followed by N and M^-1 in the
+      // extension.
+      Residue quotientFactors[Lanes];
+      Residue toExtension[Lanes][Lanes];
+      Residue toRedundant[Lanes];
+      Residue orderInExtension[Lanes];
+      Residue inverseProduct[Lanes];
+      Residue orderRedundant;
+      Residue inverseProductRedundant;
+
+      // B' to B: |M'_j|^-1 mod m'_j plainly, then |M'_j| mod m_i in
+      // Montgomery form and mod 2^32, and M' mod m_i for the exact
+      // correction.
+      Residue extensionFactors[Lanes];
+      Residue toBase[Lanes][Lanes];
+      Residue extensionToRedundant[Lanes];
+      Residue extensionProduct[Lanes];
+      Residue inverseExtensionProductRedundant;
+
+      Representation one;
+      Representation montgomeryOne;
+      Representation montgomerySquare;
+      Representation orderMultiple;
+
+      Wide cofactors[Lanes];
+      Wide product;
+      Wide order;
+
+      Constants() : order(Wide(RingTraits::Order)) {
+        std::size_t found = 0;
+        for (Residue candidate = (Residue(1) << detail::LaneBits) - 1;
+             found < 2 * Lanes;
+             candidate -= 2) {
+          if (!detail::IsLanePrime(candidate) ||
+              detail::ResidueOf(order, candidate) == 0)
+            continue;
+          if (found < Lanes)
+            moduli[found] = candidate;
+          else
+            extensionModuli[found - Lanes] = candidate;
+          ++found;
+        }
+
+        for (std::size_t i = 0; i < Lanes; ++i) {
+          setUpLane(moduli[i], negInverses[i], r[i], rSquared[i]);
+          setUpLane(extensionModuli[i], extensionNegInverses[i],
+              extensionR[i], extensionRSquared[i]);
+        }
+
+        Residue productRedundant = 1, extensionProductRedundant = 1;
+        for (std::size_t i = 0; i < Lanes; ++i) {
+          productRedundant *= moduli[i];
+          extensionProductRedundant *= extensionModuli[i];
+        }
+        orderRedundant = Residue(order.data()[0]);
+        inverseProductRedundant =
+            Residue(0) - detail::MontgomeryNegInverse(productRedundant);
+        inverseExtensionProductRedundant = Residue(0) -
+            detail::MontgomeryNegInverse(extensionProductRedundant);
+
+        for (std::size_t i = 0; i < Lanes; ++i) {
+          auto const m = moduli[i];
+          auto const orderInverse =
+              inverse(detail::ResidueOf(order, m), m);
+          quotientFactors[i] = detail::MultiplyModulo(m - orderInverse,
+              inverse(productExcept(moduli, i, m), m), m);
+          toRedundant[i] = productRedundant * inverse(m);
+          extensionProduct[i] = detail::MultiplyModulo(
+              productExcept(extensionModuli, Lanes, m), rSquared[i], m);
+          for (std::size_t j = 0; j < Lanes; ++j) {
+            toExtension[i][j] = detail::MultiplyModulo(
+                productExcept(moduli, i, extensionModuli[j]), extensionR[j],
+                extensionModuli[j]);
+          }
+        }
+
+        for (std::size_t j = 0; j < Lanes; ++j) {
+          auto const m = extensionModuli[j];
+          orderInExtension[j] = detail::LaneMultiply(
+              detail::ResidueOf(order, m), extensionRSquared[j], m,
+              extensionNegInverses[j]);
+          inverseProduct[j] = detail::LaneMultiply(
+              inverse(productExcept(moduli, Lanes, m), m),
+              extensionRSquared[j], m, extensionNegInverses[j]);
+          extensionFactors[j] =
+              inverse(productExcept(extensionModuli, j, m), m);
+          extensionToRedundant[j] = extensionProductRedundant * inverse(m);
+          for (std::size_t i = 0; i < Lanes; ++i) {
+            toBase[j][i] = detail::MultiplyModulo(
+                productExcept(extensionModuli, j, moduli[i]), r[i],
+                moduli[i]);
+          }
+        }
+
+        product = Wide(1);
+        for (std::size_t j = 0; j < Lanes; ++j) {
+          cofactors[j] = Wide(1);
+          for (std::size_t l = 0; l < Lanes; ++l) {
+            if (l != j)
+              cofactors[j] *= Wide(extensionModuli[l]);
+          }
+          product *= Wide(extensionModuli[j]);
+        }
+
+        Wide montgomery(1);
+        for (std::size_t i = 0; i < Lanes; ++i)
+          montgomery = montgomery * Wide(moduli[i]) % order;
+        montgomeryOne = residuesOf(montgomery);
+        for (std::size_t i = 0; i < Lanes; ++i)
+          montgomery = montgomery * Wide(moduli[i]) % order;
+        montgomerySquare = residuesOf(montgomery);
+
+        one = residuesOf(Wide(1));
+        orderMultiple = residuesOf(order * Wide(Lanes + 2));
+      }
+
+      // Residues of a plain integer, in the lane Montgomery form.
+      Representation residuesOf(Wide const& value) const {
+        Representation result;
+        for (std::size_t i = 0; i < Lanes; ++i) {
+          result.base[i] = detail::LaneMultiply(
+              detail::ResidueOf(value, moduli[i]), rSquared[i], moduli[i],
+              negInverses[i]);
+          result.extension[i] = detail::LaneMultiply(
+              detail::ResidueOf(value, extensionModuli[i]),
+              extensionRSquared[i], extensionModuli[i],
+              extensionNegInverses[i]);
+        }
+        result.redundant = Residue(value.data()[0]);
+        return result;
+      }
+
+    private:
+      static void setUpLane(Residue const m, Residue& negInverse,
+          Residue& montgomery, Residue& square) {
+        negInverse = detail::MontgomeryNegInverse(m);
+        montgomery = Residue((std::uint64_t(1) << detail::ResidueBits) % m);
+        square = detail::MultiplyModulo(montgomery, montgomery, m);
+      }
+
+      static Residue inverse(Residue const value, Residue const m) {
+        return detail::PowerModulo(value, m - 2, m);
+      }
+
+      // Inverse of an odd value modulo 2^32.
+      static Residue inverse(Residue const value) {
+        return Residue(0) - detail::MontgomeryNegInverse(value);
+      }
+
+      // The product of all moduli but the skipped one, modulo m.
+      static Residue productExcept(Residue const (&moduli)[Lanes],
+          std::size_t const skipped, Residue const m) {
+        Residue result = 1 % m;
+        for (std::size_t l = 0; l < Lanes; ++l) {
+          if (l != skipped)
+            result = detail::MultiplyModulo(result, moduli[l] % m, m);
+        }
+        return result;
+      }
+    };
+
+
+    static Constants const& Context() {
+      static Constants const constants;
+      return constants;
+    }
+
+
+    // Digits of the exact conversion from B': a value r held in B' and the
+    // redundant lane equals sum_j xi_j M'_j - beta M' with 0 <= beta < k,
+    // and as beta is known modulo 2^32 it is known exactly.
+    static Residue ExtensionDigits(
+        Constants const& c, Representation const& value, Residue* xi) {
+      Residue sum = 0;
+      for (std::size_t j = 0; j < Lanes; ++j) {
+        xi[j] = detail::LaneMultiply(value.extension[j],
+            c.extensionFactors[j], c.extensionModuli[j],
+            c.extensionNegInverses[j]);
+        sum += xi[j] * c.extensionToRedundant[j];
+      }
+      return (sum - value.redundant) * c.inverseExtensionProductRedundant;
+    }
+
+
+    // out_j = sum_i digits_i matrix_ij mod m_j. The products are summed up
+    // in 64 bits and folded below m_j, as hi 2^32 + lo, only once every
+    // AccumulatedProducts rows.
+    static void Extend(Residue const* digits,
+        Residue const (&matrix)[Lanes][Lanes], Residue const* moduli,
+        Residue const* negInverses, Residue const* r,
+        Residue const* rSquared, Residue* out) {
+      std::uint64_t sums[Lanes] = {};
+      for (std::size_t first = 0; first < Lanes;
+           first += detail::AccumulatedProducts) {
+        auto const last = first + detail::AccumulatedProducts < Lanes
+                              ? first + detail::AccumulatedProducts
+                              : Lanes;
+        for (std::size_t i = first; i < last; ++i) {
+          for (std::size_t j = 0; j < Lanes; ++j)
+            sums[j] += std::uint64_t(digits[i]) * matrix[i][j];
+        }
+        for (std::size_t j = 0; j < Lanes; ++j) {
+          auto const high = Residue(sums[j] >> detail::ResidueBits);
+          auto const low = Residue(sums[j]);
+          sums[j] = detail::LaneAdd(
+              detail::LaneMultiply(
+                  high, rSquared[j], moduli[j], negInverses[j]),
+              detail::LaneMultiply(low, r[j], moduli[j], negInverses[j]),
+              moduli[j]);
+        }
+      }
+      for (std::size_t j = 0; j < Lanes; ++j)
+        out[j] = Residue(sums[j]);
+    }
+
+
+    static Representation MontgomeryMultiply(
+        Representation const& lhs, Representation const& rhs) {
+      auto const& c = Context();
+      Representation result;
+
+      Residue xi[Lanes];
+      for (std::size_t i = 0; i < Lanes; ++i) {
+        auto const s = detail::LaneMultiply(
+            lhs.base[i], rhs.base[i], c.moduli[i], c.negInverses[i]);
+        xi[i] = detail::LaneMultiply(
+            s, c.quotientFactors[i], c.moduli[i], c.negInverses[i]);
+      }
+
+      Residue quotient[Lanes];
+      Extend(xi, c.toExtension, c.extensionModuli, c.extensionNegInverses,
+          c.extensionR, c.extensionRSquared, quotient);
+      Residue quotientRedundant = 0;
+      for (std::size_t i = 0; i < Lanes; ++i)
+        quotientRedundant += xi[i] * c.toRedundant[i];
+
+      for (std::size_t j = 0; j < Lanes; ++j) {
+        auto const m = c.extensionModuli[j];
+        auto const negInverse = c.extensionNegInverses[j];
+        auto const s = detail::LaneMultiply(
+            lhs.extension[j], rhs.extension[j], m, negInverse);
+        auto const t = detail::LaneAdd(s,
+            detail::LaneMultiply(
+                quotient[j], c.orderInExtension[j], m, negInverse),
+            m);
+        result.extension[j] =
+            detail::LaneMultiply(t, c.inverseProduct[j], m, negInverse);
+      }
+      result.redundant =
+          (lhs.redundant * rhs.redundant +
+              quotientRedundant * c.orderRedundant) *
+          c.inverseProductRedundant;
+
+      Residue digits[Lanes];
+      auto const beta = ExtensionDigits(c, result, digits);
+      Extend(digits, c.toBase, c.moduli, c.negInverses, c.r, c.rSquared,
+          result.base);
+      for (std::size_t i = 0; i < Lanes; ++i) {
+        auto const m = c.moduli[i];
+        result.base[i] = detail::LaneSubtract(result.base[i],
+            detail::LaneMultiply(
+                beta, c.extensionProduct[i], m, c.negInverses[i]),
+            m);
+      }
+      return result;
+    }
+
+
+    static Representation FromInteger(PrimaryType const& value) {
+      auto const& c = Context();
+      return MontgomeryMultiply(
+          c.residuesOf(Wide(value % RingTraits::Order)), c.montgomerySquare);
+    }
+
+    static PrimaryType ToInteger(Representation const& value) {
+      auto const& c = Context();
+      auto const plain = MontgomeryMultiply(value, c.one);
+
+      Residue digits[Lanes];
+      auto const beta = ExtensionDigits(c, plain, digits);
+      Wide result;
+      for (std::size_t j = 0; j < Lanes; ++j)
+        result += c.cofactors[j] * Wide(digits[j]);
+      result -= c.product * Wide(beta);
+      return PrimaryType(result % c.order);
+    }
+
+
+    static bool Equal(Representation const& lhs, Representation const& rhs) {
+      return ToInteger(lhs) == ToInteger(rhs);
+    }
+
+    static bool Less(Representation const& lhs, Representation const& rhs) {
+      return ToInteger(lhs) < ToInteger(rhs);
+    }
+
+
+    static Representation Multiply(
+        Representation const& lhs, Representation const& rhs) {
+      return MontgomeryMultiply(lhs, rhs);
+    }
+
+    static Representation Square(Representation const& value) {
+      return MontgomeryMultiply(value, value);
+    }
+
+    static Representation Add(
+        Representation const& lhs, Representation const& rhs) {
+      auto const& c = Context();
+      Representation sum;
+      for (std::size_t i = 0; i < Lanes; ++i) {
+        sum.base[i] = detail::LaneAdd(lhs.base[i], rhs.base[i], c.moduli[i]);
+        sum.extension[i] = detail::LaneAdd(
+            lhs.extension[i], rhs.extension[i], c.extensionModuli[i]);
+      }
+      sum.redundant = lhs.redundant + rhs.redundant;
+      return MontgomeryMultiply(sum, c.montgomeryOne);
+    }
+
+    // lhs + (k + 2) N - rhs, which stays positive.
+    static Representation Subtract(
+        Representation const& lhs, Representation const& rhs) {
+      auto const& c = Context();
+      auto const& multiple = c.orderMultiple;
+      Representation difference;
+      for (std::size_t i = 0; i < Lanes; ++i) {
+        auto const m = c.moduli[i];
+        auto const n = c.extensionModuli[i];
+        difference.base[i] = detail::LaneAdd(lhs.base[i],
+            detail::LaneSubtract(multiple.base[i], rhs.base[i], m), m);
+        difference.extension[i] = detail::LaneAdd(lhs.extension[i],
+            detail::LaneSubtract(multiple.extension[i], rhs.extension[i], n),
+            n);
+      }
+      difference.redundant =
+          lhs.redundant + multiple.redundant - rhs.redundant;
+      return MontgomeryMultiply(difference, c.montgomeryOne);
+    }
+
+    static Representation Negate(Representation const& value) {
+      return Subtract(Representation{}, value);
+    }
+  };
+
+} // namespace CryptoCom
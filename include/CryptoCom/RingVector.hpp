@@ -0,0 +1,663 @@
+#pragma once
+
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/Montgomery.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <CryptoCom/ResidueNumberSystem.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+
+// Brackets the AVX-512 kernels. GCC takes the deliberately undefined
+// operands inside the intrinsics for uninitialised variables once they
+// are inlined and warns about each of them.
+#define CRYPTOCOM_BEGIN_AVX512_KERNELS \
+  _Pragma("GCC diagnostic push") \
+  _Pragma("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
+#define CRYPTOCOM_END_AVX512_KERNELS _Pragma("GCC diagnostic pop")
+#endif
+
+namespace CryptoCom {
+  namespace detail {
+
+    // The constants of an odd modulus below 2^31, whose residues are kept
+    // in 32 bit Montgomery form like the lanes of a residue number system.
+    // The bound leaves a bit for the sum of two residues.
+    struct LaneModulus {
+      Residue modulus;
+      Residue negInverse;
+      Residue rSquared;
+
+      explicit constexpr LaneModulus(Residue const value)
+          : modulus(value)
+          , negInverse(MontgomeryNegInverse(value))
+          , rSquared(MontgomeryRSquared<Residue, std::uint64_t>(value)) {}
+    };
+
+
+    // Element-wise kernels over arrays of lanes, one lane at a time. They
+    // also finish the tails the vector kernels leave.
+    struct ScalarLanes {
+      static void Add(Residue* out, Residue const* a, Residue const* b,
+          std::size_t const count, LaneModulus const& m) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = LaneAdd(a[idx], b[idx], m.modulus);
+      }
+
+      static void Subtract(Residue* out, Residue const* a, Residue const* b,
+          std::size_t const count, LaneModulus const& m) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = LaneSubtract(a[idx], b[idx], m.modulus);
+      }
+
+      static void Multiply(Residue* out, Residue const* a, Residue const* b,
+          std::size_t const count, LaneModulus const& m) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = LaneMultiply(a[idx], b[idx], m.modulus, m.negInverse);
+      }
+
+      static void MultiplyScalar(Residue* out, Residue const* a,
+          Residue const scalar, std::size_t const count,
+          LaneModulus const& m) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = LaneMultiply(a[idx], scalar, m.modulus, m.negInverse);
+      }
+
+      static Residue Dot(Residue const* a, Residue const* b,
+          std::size_t const count, LaneModulus const& m) {
+        Residue result = 0;
+        for (std::size_t idx = 0; idx < count; ++idx) {
+          result = LaneAdd(result,
+              LaneMultiply(a[idx], b[idx], m.modulus, m.negInverse),
+              m.modulus);
+        }
+        return result;
+      }
+
+      static Residue Sum(
+          Residue const* a, std::size_t const count, LaneModulus const& m) {
+        Residue result = 0;
+        for (std::size_t idx = 0; idx < count; ++idx)
+          result = LaneAdd(result, a[idx], m.modulus);
+        return result;
+      }
+    };
+
+
+#if defined(__x86_64__)
+    // Eight lanes per AVX2 register. The multiplication instruction only
+    // takes the even 32 bit lanes into 64 bit products, so the odd lanes
+    // are shifted down, reduced alongside and blended back. Every final
+    // subtraction of the modulus is a minimum: x - m wraps above x whenever
+    // x < m.
+    __attribute__((target("avx2"))) inline __m256i LaneRedcAvx2(
+        __m256i const t, __m256i const modulus, __m256i const negInverse) {
+      auto const m = _mm256_mul_epu32(t, negInverse);
+      return _mm256_add_epi64(t, _mm256_mul_epu32(m, modulus));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i LaneMultiplyAvx2(
+        __m256i const a, __m256i const b, __m256i const modulus,
+        __m256i const negInverse) {
+      auto const even =
+          LaneRedcAvx2(_mm256_mul_epu32(a, b), modulus, negInverse);
+      auto const odd = LaneRedcAvx2(
+          _mm256_mul_epu32(_mm256_srli_epi64(a, 32), _mm256_srli_epi64(b, 32)),
+          modulus, negInverse);
+      auto const u =
+          _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xaa);
+      return _mm256_min_epu32(u, _mm256_sub_epi32(u, modulus));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i LaneAddAvx2(
+        __m256i const a, __m256i const b, __m256i const modulus) {
+      auto const sum = _mm256_add_epi32(a, b);
+      return _mm256_min_epu32(sum, _mm256_sub_epi32(sum, modulus));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i LaneSubtractAvx2(
+        __m256i const a, __m256i const b, __m256i const modulus) {
+      auto const difference = _mm256_sub_epi32(a, b);
+      return _mm256_min_epu32(
+          difference, _mm256_add_epi32(difference, modulus));
+    }
+
+    __attribute__((target("avx2"))) inline __m256i LoadAvx2(
+        Residue const* lanes) {
+      return _mm256_loadu_si256(reinterpret_cast<__m256i const*>(lanes));
+    }
+
+    __attribute__((target("avx2"))) inline void StoreAvx2(
+        Residue* lanes, __m256i const value) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(lanes), value);
+    }
+
+
+    struct Avx2Lanes {
+      static constexpr std::size_t Width = 8;
+
+      __attribute__((target("avx2"))) static void Add(Residue* out,
+          Residue const* a, Residue const* b, std::size_t const count,
+          LaneModulus const& m) {
+        auto const modulus = _mm256_set1_epi32(int(m.modulus));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          StoreAvx2(out + idx,
+              LaneAddAvx2(LoadAvx2(a + idx), LoadAvx2(b + idx), modulus));
+        }
+        ScalarLanes::Add(out + idx, a + idx, b + idx, count - idx, m);
+      }
+
+      __attribute__((target("avx2"))) static void Subtract(Residue* out,
+          Residue const* a, Residue const* b, std::size_t const count,
+          LaneModulus const& m) {
+        auto const modulus = _mm256_set1_epi32(int(m.modulus));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          StoreAvx2(out + idx, LaneSubtractAvx2(
+                                   LoadAvx2(a + idx), LoadAvx2(b + idx),
+                                   modulus));
+        }
+        ScalarLanes::Subtract(out + idx, a + idx, b + idx, count - idx, m);
+      }
+
+      __attribute__((target("avx2"))) static void Multiply(Residue* out,
+          Residue const* a, Residue const* b, std::size_t const count,
+          LaneModulus const& m) {
+        auto const modulus = _mm256_set1_epi32(int(m.modulus));
+        auto const negInverse = _mm256_set1_epi32(int(m.negInverse));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          StoreAvx2(out + idx, LaneMultiplyAvx2(LoadAvx2(a + idx),
+                                   LoadAvx2(b + idx), modulus, negInverse));
+        }
+        ScalarLanes::Multiply(out + idx, a + idx, b + idx, count - idx, m);
+      }
+
+      __attribute__((target("avx2"))) static void MultiplyScalar(
+          Residue* out, Residue const* a, Residue const scalar,
+          std::size_t const count, LaneModulus const& m) {
+        auto const modulus = _mm256_set1_epi32(int(m.modulus));
+        auto const negInverse = _mm256_set1_epi32(int(m.negInverse));
+        auto const factor = _mm256_set1_epi32(int(scalar));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          StoreAvx2(out + idx, LaneMultiplyAvx2(LoadAvx2(a + idx), factor,
+                                   modulus, negInverse));
+        }
+        ScalarLanes::MultiplyScalar(
+            out + idx, a + idx, scalar, count - idx, m);
+      }
+
+      __attribute__((target("avx2"))) static Residue Dot(Residue const* a,
+          Residue const* b, std::size_t const count, LaneModulus const& m) {
+        auto const modulus = _mm256_set1_epi32(int(m.modulus));
+        auto const negInverse = _mm256_set1_epi32(int(m.negInverse));
+        auto sum = _mm256_setzero_si256();
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          sum = LaneAddAvx2(sum, LaneMultiplyAvx2(LoadAvx2(a + idx),
+                                     LoadAvx2(b + idx), modulus, negInverse),
+              modulus);
+        }
+        Residue lanes[Width];
+        StoreAvx2(lanes, sum);
+        return LaneAdd(ScalarLanes::Sum(lanes, Width, m),
+            ScalarLanes::Dot(a + idx, b + idx, count - idx, m), m.modulus);
+      }
+
+      __attribute__((target("avx2"))) static Residue Sum(
+          Residue const* a, std::size_t const count, LaneModulus const& m) {
+        auto const modulus = _mm256_set1_epi32(int(m.modulus));
+        auto sum = _mm256_setzero_si256();
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width)
+          sum = LaneAddAvx2(sum, LoadAvx2(a + idx), modulus);
+        Residue lanes[Width];
+        StoreAvx2(lanes, sum);
+        return LaneAdd(ScalarLanes::Sum(lanes, Width, m),
+            ScalarLanes::Sum(a + idx, count - idx, m), m.modulus);
+      }
+    };
+
+
+    CRYPTOCOM_BEGIN_AVX512_KERNELS
+
+    // The same with sixteen lanes per AVX-512 register, where blending
+    // takes a mask register.
+    __attribute__((target("avx512f"))) inline __m512i LaneRedcAvx512(
+        __m512i const t, __m512i const modulus, __m512i const negInverse) {
+      auto const m = _mm512_mul_epu32(t, negInverse);
+      return _mm512_add_epi64(t, _mm512_mul_epu32(m, modulus));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i LaneMultiplyAvx512(
+        __m512i const a, __m512i const b, __m512i const modulus,
+        __m512i const negInverse) {
+      auto const even =
+          LaneRedcAvx512(_mm512_mul_epu32(a, b), modulus, negInverse);
+      auto const odd = LaneRedcAvx512(
+          _mm512_mul_epu32(_mm512_srli_epi64(a, 32), _mm512_srli_epi64(b, 32)),
+          modulus, negInverse);
+      auto const u =
+          _mm512_mask_blend_epi32(0xaaaa, _mm512_srli_epi64(even, 32), odd);
+      return _mm512_min_epu32(u, _mm512_sub_epi32(u, modulus));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i LaneAddAvx512(
+        __m512i const a, __m512i const b, __m512i const modulus) {
+      auto const sum = _mm512_add_epi32(a, b);
+      return _mm512_min_epu32(sum, _mm512_sub_epi32(sum, modulus));
+    }
+
+    __attribute__((target("avx512f"))) inline __m512i LaneSubtractAvx512(
+        __m512i const a, __m512i const b, __m512i const modulus) {
+      auto const difference = _mm512_sub_epi32(a, b);
+      return _mm512_min_epu32(
+          difference, _mm512_add_epi32(difference, modulus));
+    }
+
+
+    struct Avx512Lanes {
+      static constexpr std::size_t Width = 16;
+
+      __attribute__((target("avx512f"))) static void Add(Residue* out,
+          Residue const* a, Residue const* b, std::size_t const count,
+          LaneModulus const& m) {
+        auto const modulus = _mm512_set1_epi32(int(m.modulus));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          _mm512_storeu_si512(out + idx,
+              LaneAddAvx512(_mm512_loadu_si512(a + idx),
+                  _mm512_loadu_si512(b + idx), modulus));
+        }
+        ScalarLanes::Add(out + idx, a + idx, b + idx, count - idx, m);
+      }
+
+      __attribute__((target("avx512f"))) static void Subtract(Residue* out,
+          Residue const* a, Residue const* b, std::size_t const count,
+          LaneModulus const& m) {
+        auto const modulus = _mm512_set1_epi32(int(m.modulus));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          _mm512_storeu_si512(out + idx,
+              LaneSubtractAvx512(_mm512_loadu_si512(a + idx),
+                  _mm512_loadu_si512(b + idx), modulus));
+        }
+        ScalarLanes::Subtract(out + idx, a + idx, b + idx, count - idx, m);
+      }
+
+      __attribute__((target("avx512f"))) static void Multiply(Residue* out,
+          Residue const* a, Residue const* b, std::size_t const count,
+          LaneModulus const& m) {
+        auto const modulus = _mm512_set1_epi32(int(m.modulus));
+        auto const negInverse = _mm512_set1_epi32(int(m.negInverse));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          _mm512_storeu_si512(out + idx,
+              LaneMultiplyAvx512(_mm512_loadu_si512(a + idx),
+                  _mm512_loadu_si512(b + idx), modulus, negInverse));
+        }
+        ScalarLanes::Multiply(out + idx, a + idx, b + idx, count - idx, m);
+      }
+
+      __attribute__((target("avx512f"))) static void MultiplyScalar(
+          Residue* out, Residue const* a, Residue const scalar,
+          std::size_t const count, LaneModulus const& m) {
+        auto const modulus = _mm512_set1_epi32(int(m.modulus));
+        auto const negInverse = _mm512_set1_epi32(int(m.negInverse));
+        auto const factor = _mm512_set1_epi32(int(scalar));
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          _mm512_storeu_si512(out + idx,
+              LaneMultiplyAvx512(_mm512_loadu_si512(a + idx), factor,
+                  modulus, negInverse));
+        }
+        ScalarLanes::MultiplyScalar(
+            out + idx, a + idx, scalar, count - idx, m);
+      }
+
+      __attribute__((target("avx512f"))) static Residue Dot(Residue const* a,
+          Residue const* b, std::size_t const count, LaneModulus const& m) {
+        auto const modulus = _mm512_set1_epi32(int(m.modulus));
+        auto const negInverse = _mm512_set1_epi32(int(m.negInverse));
+        auto sum = _mm512_setzero_si512();
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width) {
+          sum = LaneAddAvx512(sum,
+              LaneMultiplyAvx512(_mm512_loadu_si512(a + idx),
+                  _mm512_loadu_si512(b + idx), modulus, negInverse),
+              modulus);
+        }
+        Residue lanes[Width];
+        _mm512_storeu_si512(lanes, sum);
+        return LaneAdd(ScalarLanes::Sum(lanes, Width, m),
+            ScalarLanes::Dot(a + idx, b + idx, count - idx, m), m.modulus);
+      }
+
+      __attribute__((target("avx512f"))) static Residue Sum(
+          Residue const* a, std::size_t const count, LaneModulus const& m) {
+        auto const modulus = _mm512_set1_epi32(int(m.modulus));
+        auto sum = _mm512_setzero_si512();
+        std::size_t idx = 0;
+        for (; idx + Width <= count; idx += Width)
+          sum = LaneAddAvx512(sum, _mm512_loadu_si512(a + idx), modulus);
+        Residue lanes[Width];
+        _mm512_storeu_si512(lanes, sum);
+        return LaneAdd(ScalarLanes::Sum(lanes, Width, m),
+            ScalarLanes::Sum(a + idx, count - idx, m), m.modulus);
+      }
+    };
+
+    CRYPTOCOM_END_AVX512_KERNELS
+#endif
+
+
+    enum class LaneWidth { Scalar, Avx2, Avx512 };
+
+    // The widest vector unit of the running processor, determined once.
+    // Unlike a bare CPUID query this also makes sure the operating system
+    // saves the wider registers.
+    inline LaneWidth SupportedLaneWidth() {
+#if defined(__x86_64__)
+      static LaneWidth const width = []() {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+          return LaneWidth::Avx512;
+        if (__builtin_cpu_supports("avx2"))
+          return LaneWidth::Avx2;
+        return LaneWidth::Scalar;
+      }();
+      return width;
+#else
+      return LaneWidth::Scalar;
+#endif
+    }
+
+
+    // Calls function with the lane kernels of the widest supported unit.
+    template <typename Function>
+    auto WithLaneKernels(Function&& function) {
+#if defined(__x86_64__)
+      switch (SupportedLaneWidth()) {
+      case LaneWidth::Avx512:
+        return function(Avx512Lanes{});
+      case LaneWidth::Avx2:
+        return function(Avx2Lanes{});
+      case LaneWidth::Scalar:
+        break;
+      }
+#endif
+      return function(ScalarLanes{});
+    }
+
+
+    // Whether the elements of a ring fit lanes of odd moduli below
+    // 2^Bits: odd, word sized orders of at most Bits bits known at compile
+    // time.
+    template <typename RingTraits, int Bits,
+        bool = IsFixedInteger<typename RingTraits::PrimaryType>::value,
+        typename = typename ReductionTagOf<RingTraits>::type>
+    struct FitsLanes
+        : std::integral_constant<bool,
+              RingTraits::Order % 2 == 1 &&
+                  BitLength(typename UnsignedOf<typename RingTraits::
+                          PrimaryType>::type(RingTraits::Order)) <= Bits> {};
+
+    template <typename RingTraits, int Bits, typename Tag>
+    struct FitsLanes<RingTraits, Bits, true, Tag> : std::false_type {};
+
+    template <typename RingTraits, int Bits>
+    struct FitsLanes<RingTraits, Bits, false, DynamicReduction>
+        : std::false_type {};
+
+    // The 32 bit lanes, which leave a bit for the sum of two residues.
+    template <typename RingTraits>
+    using HasLaneOrder = FitsLanes<RingTraits, 31>;
+
+
+    // How a RingVector keeps its elements: any ring as a plain array of its
+    // elements, with the ring's own arithmetic applied one at a time.
+    template <typename RingTraits, bool = HasLaneOrder<RingTraits>::value>
+    struct RingVectorElements {
+      using Ring = CyclicRing<RingTraits>;
+      using Element = Ring;
+
+      static Element FromRing(Ring const& value) { return value; }
+      static Ring ToRing(Element const& value) { return value; }
+
+      static void Add(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = a[idx] + b[idx];
+      }
+
+      static void Subtract(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = a[idx] - b[idx];
+      }
+
+      static void Multiply(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = a[idx] * b[idx];
+      }
+
+      static void MultiplyScalar(Element* out, Element const* a,
+          Element const& scalar, std::size_t const count) {
+        for (std::size_t idx = 0; idx < count; ++idx)
+          out[idx] = a[idx] * scalar;
+      }
+
+      static Ring Dot(
+          Element const* a, Element const* b, std::size_t const count) {
+        auto result = Ring::Zero();
+        for (std::size_t idx = 0; idx < count; ++idx)
+          result += a[idx] * b[idx];
+        return result;
+      }
+
+      static Ring Sum(Element const* a, std::size_t const count) {
+        auto result = Ring::Zero();
+        for (std::size_t idx = 0; idx < count; ++idx)
+          result += a[idx];
+        return result;
+      }
+    };
+
+
+    // Rings which fit the lanes keep their elements as 32 bit Montgomery
+    // residues of their own, whatever the ring's kernel, so that a vector
+    // register holds as many elements as it has 32 bit lanes.
+    template <typename RingTraits>
+    struct RingVectorElements<RingTraits, true> {
+      using Ring = CyclicRing<RingTraits>;
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using Element = Residue;
+
+      static LaneModulus const& Modulus() {
+        static constexpr LaneModulus modulus{Residue(RingTraits::Order)};
+        return modulus;
+      }
+
+      static Element FromRing(Ring const& value) {
+        auto const& m = Modulus();
+        return LaneMultiply(Residue(value.ordinalIndex()), m.rSquared,
+            m.modulus, m.negInverse);
+      }
+
+      static Ring ToRing(Element const value) {
+        auto const& m = Modulus();
+        return Ring{
+            PrimaryType(LaneMultiply(value, 1, m.modulus, m.negInverse))};
+      }
+
+      static void Add(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+        WithLaneKernels([&](auto kernels) {
+          decltype(kernels)::Add(out, a, b, count, Modulus());
+        });
+      }
+
+      static void Subtract(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+        WithLaneKernels([&](auto kernels) {
+          decltype(kernels)::Subtract(out, a, b, count, Modulus());
+        });
+      }
+
+      static void Multiply(Element* out, Element const* a, Element const* b,
+          std::size_t const count) {
+        WithLaneKernels([&](auto kernels) {
+          decltype(kernels)::Multiply(out, a, b, count, Modulus());
+        });
+      }
+
+      static void MultiplyScalar(Element* out, Element const* a,
+          Element const scalar, std::size_t const count) {
+        WithLaneKernels([&](auto kernels) {
+          decltype(kernels)::MultiplyScalar(
+              out, a, scalar, count, Modulus());
+        });
+      }
+
+      static Ring Dot(
+          Element const* a, Element const* b, std::size_t const count) {
+        return ToRing(WithLaneKernels([&](auto kernels) {
+          return decltype(kernels)::Dot(a, b, count, Modulus());
+        }));
+      }
+
+      static Ring Sum(Element const* a, std::size_t const count) {
+        return ToRing(WithLaneKernels([&](auto kernels) {
+          return decltype(kernels)::Sum(a, count, Modulus());
+        }));
+      }
+    };
+
+  } // namespace detail
+
+
+  // A vector of elements of one ring with element-wise arithmetic. The
+  // elements of rings of an odd order below 2^31 are kept as 32 bit
+  // Montgomery residues in one contiguous array, a structure of arrays,
+  // which the arithmetic processes 16 or 8 at a time where the processor
+  // has AVX-512 or AVX2 and one at a time otherwise. Any other ring keeps
+  // an array of its elements and applies its own arithmetic to each. Both
+  // operands of an element-wise operation have to be of the same size.
+  template <typename RingTraits>
+  class RingVector {
+    using Elements = detail::RingVectorElements<RingTraits>;
+    using Element = typename Elements::Element;
+
+    std::vector<Element> elements_;
+
+    void requireSameSize(RingVector const& other) const {
+      if (elements_.size() != other.elements_.size())
+        throw std::invalid_argument("ring vectors differ in size");
+    }
+
+  public:
+    using Ring = CyclicRing<RingTraits>;
+
+    RingVector() = default;
+
+    explicit RingVector(std::size_t const size)
+        : elements_(size, Elements::FromRing(Ring::Zero())) {}
+
+    template <typename InputIt>
+    RingVector(InputIt first, InputIt last) {
+      for (; first != last; ++first)
+        elements_.push_back(Elements::FromRing(Ring(*first)));
+    }
+
+    RingVector(std::initializer_list<Ring> elements)
+        : RingVector(elements.begin(), elements.end()) {}
+
+    std::size_t size() const { return elements_.size(); }
+
+    Ring operator[](std::size_t const idx) const {
+      return Elements::ToRing(elements_[idx]);
+    }
+
+    void set(std::size_t const idx, Ring const& value) {
+      elements_[idx] = Elements::FromRing(value);
+    }
+
+    bool operator==(RingVector const& other) const {
+      return elements_ == other.elements_;
+    }
+
+    bool operator!=(RingVector const& other) const {
+      return !(*this == other);
+    }
+
+
+    RingVector& operator+=(RingVector const& other) {
+      requireSameSize(other);
+      Elements::Add(elements_.data(), elements_.data(),
+          other.elements_.data(), elements_.size());
+      return *this;
+    }
+
+    RingVector& operator-=(RingVector const& other) {
+      requireSameSize(other);
+      Elements::Subtract(elements_.data(), elements_.data(),
+          other.elements_.data(), elements_.size());
+      return *this;
+    }
+
+    RingVector& operator*=(RingVector const& other) {
+      requireSameSize(other);
+      Elements::Multiply(elements_.data(), elements_.data(),
+          other.elements_.data(), elements_.size());
+      return *this;
+    }
+
+    RingVector& operator*=(Ring const& scalar) {
+      Elements::MultiplyScalar(elements_.data(), elements_.data(),
+          Elements::FromRing(scalar), elements_.size());
+      return *this;
+    }
+
+    RingVector operator+(RingVector const& other) const {
+      auto result = *this;
+      return result += other;
+    }
+
+    RingVector operator-(RingVector const& other) const {
+      auto result = *this;
+      return result -= other;
+    }
+
+    RingVector operator*(RingVector const& other) const {
+      auto result = *this;
+      return result *= other;
+    }
+
+    RingVector operator*(Ring const& scalar) const {
+      auto result = *this;
+      return result *= scalar;
+    }
+
+
+    // The sum of the element-wise products.
+    Ring dot(RingVector const& other) const {
+      requireSameSize(other);
+      return Elements::Dot(
+          elements_.data(), other.elements_.data(), elements_.size());
+    }
+
+    Ring sum() const { return Elements::Sum(elements_.data(), size()); }
+  };
+
+} // namespace CryptoCom
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/IntegerTraits.hpp>
+#include <CryptoCom/LimbArithmetic.hpp>
+#include <CryptoCom/Reduction.hpp>
+#include <cstddef>
+#include <type_traits>
+
+namespace CryptoCom {
+
+  namespace detail {
+
+    // Special form kernel for orders which fit a machine word. Products are
+    // folded within the EscalationType, all of it constexpr.
+    template <typename RingTraits>
+    struct WordSpecialForm : public ModularAddition<RingTraits> {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using EscalationType = typename RingTraits::EscalationType;
+      using Representation = PrimaryType;
+
+      using Word = typename UnsignedOf<PrimaryType>::type;
+      using DoubleWord = typename UnsignedOf<EscalationType>::type;
+
+      static constexpr Word Order = Word(RingTraits::Order);
+      static constexpr int OrderBits = BitLength(Order);
+      static constexpr DoubleWord Offset =
+          (DoubleWord(1) << OrderBits) - Order;
+      static constexpr DoubleWord Mask = (DoubleWord(1) << OrderBits) - 1;
+
+      static_assert(IsSpecialForm(Order),
+          "the order has to be 2^k - c for a c below 2^(k/2)");
+      static_assert(2 * OrderBits <= Digits<DoubleWord>::value,
+          "the EscalationType has to hold the square of the order");
+
+      static constexpr Word Reduce(DoubleWord value) {
+        while ((value >> OrderBits) != 0)
+          value = (value >> OrderBits) * Offset + (value & Mask);
+        return Word(value) >= Order ? Word(value - Order) : Word(value);
+      }
+
+      static constexpr Representation FromInteger(PrimaryType const value) {
+        return ModularAddition<RingTraits>::Canonical(value);
+      }
+
+      static constexpr PrimaryType ToInteger(Representation const value) {
+        return value;
+      }
+
+      static constexpr Representation Multiply(
+          Representation const lhs, Representation const rhs) {
+        return Representation(Reduce(DoubleWord(Word(lhs)) * Word(rhs)));
+      }
+
+      static constexpr Representation Square(Representation const value) {
+        return Multiply(value, value);
+      }
+
+      // Folding shrinks any double word, so LazyAccumulator may fill it up.
+      static constexpr DoubleWord ProductBound() {
+        return MaxOf<DoubleWord>();
+      }
+
+      static constexpr Representation ReduceProduct(DoubleWord const value) {
+        return Representation(Reduce(value));
+      }
+    };
+
+
+    // Special form kernel for FixedUInt orders. The product comes from the
+    // limb kernels, folding multiplies its upper part by the one word
+    // offset only.
+    template <typename RingTraits>
+    struct LimbSpecialForm : public ModularAddition<RingTraits> {
+      using PrimaryType = typename RingTraits::PrimaryType;
+      using Representation = PrimaryType;
+      using Limb = typename PrimaryType::Limb;
+      static constexpr std::size_t LimbCount = PrimaryType::LimbCount;
+      static constexpr int LimbBits = PrimaryType::LimbBits;
+
+      using Wide = FixedUInt<2 * LimbBits * LimbCount>;
+
+      static constexpr PrimaryType Order = RingTraits::Order;
+      static constexpr int OrderBits = BitLength(RingTraits::Order);
+      static constexpr Limb Offset =
+          Limb(((PrimaryType(1) << OrderBits) - RingTraits::Order).data()[0]);
+      static constexpr Wide Mask = (Wide(1) << OrderBits) - 1;
+
+      static_assert(IsSpecialForm(RingTraits::Order),
+          "the order has to be 2^k - c for a c below 2^(k/2) and 2^64");
+
+      // value * factor, for values which don't carry out of Wide.
+      static Wide MultiplyLimb(Wide const& value, Limb const factor) {
+        Wide result;
+        Limb carry = 0;
+        for (std::size_t j = 0; j < Wide::LimbCount; ++j) {
+          auto const term = UInt128(value.data()[j]) * factor + carry;
+          result.data()[j] = Limb(term);
+          carry = Limb(term >> LimbBits);
+        }
+        return result;
+      }
+
+      static PrimaryType Reduce(Limb const* product) {
+        Wide value;
+        for (std::size_t j = 0; j < Wide::LimbCount; ++j)
+          value.data()[j] = product[j];
+
+        for (auto high = value >> OrderBits; high != 0;
+             high = value >> OrderBits) {
+          value = MultiplyLimb(high, Offset) + (value & Mask);
+        }
+
+        auto result = PrimaryType(value);
+        if (result >= Order)
+          result -= Order;
+        return result;
+      }
+
+      static constexpr Representation FromInteger(PrimaryType const value) {
+        return ModularAddition<RingTraits>::Canonical(value);
+      }
+
+      static constexpr PrimaryType ToInteger(Representation const value) {
+        return value;
+      }
+
+      static Representation Multiply(
+          Representation const& lhs, Representation const& rhs) {
+        Limb product[2 * LimbCount];
+        LimbProduct<LimbCount>::Multiply(lhs.data(), rhs.data(), product);
+        return Reduce(product);
+      }
+
+      static Representation Square(Representation const& value) {
+        Limb product[2 * LimbCount];
+        LimbSquare<LimbCount>::Square(value.data(), product);
+        return Reduce(product);
+      }
+    };
+
+    template <typename RingTraits>
+    constexpr typename RingTraits::PrimaryType
+        LimbSpecialForm<RingTraits>::Order;
+
+    template <typename RingTraits>
+    constexpr typename LimbSpecialForm<RingTraits>::Wide
+        LimbSpecialForm<RingTraits>::Mask;
+
+  } // namespace detail
+
+
+  // Orders 2^k - c with a small offset c reduce without any division or
+  // multiplication by the order: as 2^k = c modulo the order, the bits of
+  // a product x = h 2^k + l above the k-th fold into h c + l, which shrinks
+  // by about k - log c bits per step. For Mersenne orders c = 1 and a fold
+  // is a shift and an addition, for Solinas orders like 2^k - 2^b + 1 the
+  // multiplication by c is a shift and a subtraction. Residues stay
+  // canonical, like with division.
+  template <typename RingTraits>
+  struct ReductionKernel<SpecialFormReduction, RingTraits>
+      : public std::conditional<
+            detail::IsFixedInteger<typename RingTraits::PrimaryType>::value,
+            detail::LimbSpecialForm<RingTraits>,
+            detail::WordSpecialForm<RingTraits>>::type {};
+
+} // namespace CryptoCom
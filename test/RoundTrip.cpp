@@ -17,12 +17,17 @@ std::ostream& operator<<(std::ostream& ostr, std::set<int32_t> const& v) {
 }
 
 
+// The safe prime p = 2 q + 1 below 2^32, the squares modulo p form the
+// subgroup of order q.
 struct RingTraits {
   using PrimaryType = int64_t;
-  using EscalationType = int64_t;
+  using EscalationType = CryptoCom::UInt128;
   using CoefficientType = int64_t;
-  static constexpr PrimaryType Order{2250635938};
-  static constexpr PrimaryType Generator{3};
+  using Reduction = CryptoCom::BarrettReduction;
+  using StorageType = uint32_t;
+  static constexpr PrimaryType Order{4294967087};
+  static constexpr PrimaryType SubgroupOrder{2147483543};
+  static constexpr PrimaryType Generator{4};
   static constexpr PrimaryType AdditiveIdentity{0};
   static constexpr PrimaryType MultiplicativeIdentity{1};
 };
@@ -56,10 +61,11 @@ SCENARIO(
   };
 
   Ring public_key, private_key;
-  std::tie(public_key, private_key) = Encryption::KeyPairOf(rng);
+  std::tie(private_key, public_key) = Encryption::KeyPairOf(rng);
 
   GIVEN("a client and a server set") {
-    ClientSet client_set{public_key, private_key, {2, 4, 6}, rng};
+    CryptoCom::PreparedPublicKey<RingTraits> const prepared_key{public_key};
+    ClientSet client_set{prepared_key, private_key, {2, 4, 6}, rng};
     ServerSet server_set{{3, 6, 9}};
 
     WHEN("calculating the encrypted polynomial and evaluating it on the server "
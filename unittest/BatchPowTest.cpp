@@ -0,0 +1,143 @@
+#include <CryptoCom/BatchPow.hpp>
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+  struct LaneRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    static constexpr PrimaryType Order{2147483629}; // 2^31 - 19
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct WideLaneRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{1125899906842597}; // 2^50 - 27
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct EvenRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::BarrettReduction;
+
+    static constexpr PrimaryType Order{2250635938};
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  static_assert(CryptoCom::detail::HasWideLaneOrder<WideLaneRingTraits>::
+                        value &&
+                    !CryptoCom::detail::HasWideLaneOrder<LaneRingTraits>::
+                        value &&
+                    !CryptoCom::detail::HasWideLaneOrder<EvenRingTraits>::
+                        value,
+      "orders of 32 to 51 bits fit the wide lanes");
+
+
+  // Checks batches of every size up to past a chunk against pow, with
+  // exponents of every length, zero and negative ones included.
+  template <typename Traits>
+  void CheckAgainstPow(std::mt19937_64& engine) {
+    using Ring = CryptoCom::CyclicRing<Traits>;
+    for (std::size_t size : {0, 1, 7, 8, 17, 100, 300}) {
+      std::vector<Ring> bases;
+      std::vector<int64_t> exponents;
+      for (std::size_t idx = 0; idx < size; ++idx) {
+        bases.emplace_back(int64_t(engine() >> 1));
+        exponents.push_back(int64_t(engine() >> (1 + idx % 64)));
+      }
+      if (size > 5) {
+        exponents[1] = 0;
+        bases[2] = Ring{3}; // invertible in the even order ring as well
+        exponents[2] = -exponents[3];
+        exponents[4] = 1;
+      }
+
+      auto const powers = CryptoCom::BatchPow(bases, exponents);
+      REQUIRE(powers.size() == size);
+      for (std::size_t idx = 0; idx < size; ++idx) {
+        REQUIRE(powers[idx].ordinalIndex() ==
+                bases[idx].pow(exponents[idx]).ordinalIndex());
+      }
+    }
+  }
+} // namespace
+
+
+TEST_CASE("Batch exponentiation") {
+  std::mt19937_64 engine;
+
+  SECTION("agrees with raising the bases one by one") {
+    CheckAgainstPow<LaneRingTraits>(engine);
+    CheckAgainstPow<WideLaneRingTraits>(engine);
+    CheckAgainstPow<EvenRingTraits>(engine);
+  }
+
+  SECTION("takes ring elements as exponents") {
+    using Ring = CryptoCom::CyclicRing<LaneRingTraits>;
+    std::vector<Ring> bases, exponents;
+    for (int64_t idx = 0; idx < 40; ++idx) {
+      bases.emplace_back(idx - 20);
+      exponents.emplace_back(int64_t(engine() >> 1));
+    }
+    auto const powers = CryptoCom::BatchPow(bases, exponents);
+    for (std::size_t idx = 0; idx < bases.size(); ++idx) {
+      REQUIRE(powers[idx].ordinalIndex() ==
+              bases[idx].pow(exponents[idx]).ordinalIndex());
+    }
+  }
+
+  SECTION("needs as many exponents as bases") {
+    using Ring = CryptoCom::CyclicRing<LaneRingTraits>;
+    std::vector<Ring> const bases{2, 3};
+    std::vector<int> const exponents{5};
+    REQUIRE_THROWS_AS(CryptoCom::BatchPow(bases, exponents),
+        std::invalid_argument const&);
+  }
+}
+
+
+TEST_CASE("IFMA lanes agree with the scalar 52 bit lanes") {
+  CryptoCom::detail::WideLaneModulus const m{1125899906842597};
+  std::mt19937_64 engine;
+  std::vector<uint64_t> a(45), b(45), actual(45);
+  for (std::size_t idx = 0; idx < a.size(); ++idx) {
+    a[idx] = engine() % m.modulus;
+    b[idx] = engine() % m.modulus;
+  }
+  a[0] = b[0] = m.modulus - 1;
+
+  REQUIRE(CryptoCom::detail::WideLaneMultiply(
+              CryptoCom::detail::WideLaneMultiply(7, m.rSquared, m), 1, m) ==
+          7);
+#if defined(__x86_64__)
+  if (CryptoCom::detail::HasIfma()) {
+    CryptoCom::detail::WideLaneMultiplyAllIfma(
+        actual.data(), a.data(), b.data(), a.size(), m);
+    for (std::size_t idx = 0; idx < a.size(); ++idx) {
+      REQUIRE(actual[idx] ==
+              CryptoCom::detail::WideLaneMultiply(a[idx], b[idx], m));
+    }
+  }
+#endif
+}
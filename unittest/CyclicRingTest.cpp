@@ -1,6 +1,7 @@
 #include <catch/catch.hpp>
 
 #include <CryptoCom/CyclicRing.hpp>
+#include <vector>
 
 struct TestRingTraits {
   using PrimaryType = int32_t;
@@ -75,8 +76,402 @@ TEST_CASE("In cyclic rings") {
     REQUIRE(a.pow(-2) == TestRing{9}.inverse());
   }
 
+  SECTION("batch inversion inverts every element") {
+    std::vector<TestRing> elements;
+    for (int32_t idx = 1; idx < TestRingTraits::Order; ++idx)
+      elements.push_back(idx);
+    auto inverses = elements;
+    CryptoCom::BatchInverse(inverses.begin(), inverses.end());
+    for (std::size_t idx = 0; idx < elements.size(); ++idx)
+      REQUIRE(inverses[idx] == elements[idx].inverse());
+
+    std::vector<TestRing> single{5};
+    CryptoCom::BatchInverse(single.begin(), single.end());
+    REQUIRE(single.front() * 5 == one);
+
+    std::vector<TestRing> withZero{3, 0, 4};
+    REQUIRE_THROWS(CryptoCom::BatchInverse(withZero.begin(), withZero.end()));
+  }
+
   SECTION("operator ^ is power") {
     constexpr TestRing three{3};
     REQUIRE((three ^ 2) == 9);
   }
 }
+
+
+struct MontgomeryRingTraits : public TestRingTraits {
+  using Reduction = CryptoCom::MontgomeryReduction;
+};
+using MontgomeryRing = CryptoCom::CyclicRing<MontgomeryRingTraits>;
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(std::ostream& ostr, MontgomeryRing const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+} // namespace CryptoCom
+
+
+TEST_CASE("In cyclic rings of Montgomery form") {
+  SECTION("elements read back as the integer they were constructed from") {
+    constexpr MontgomeryRing a{3};
+    static_assert(a.ordinalIndex() == 3, "converted at compile time");
+    REQUIRE(MontgomeryRing{-3}.ordinalIndex() == 34);
+  }
+
+  SECTION("arithmetic agrees with the division based ring") {
+    for (int32_t a = 0; a < TestRingTraits::Order; ++a) {
+      for (int32_t b = 0; b < TestRingTraits::Order; ++b) {
+        MontgomeryRing const x{a}, y{b};
+        TestRing const u{a}, v{b};
+        REQUIRE((x + y).ordinalIndex() == (u + v).ordinalIndex());
+        REQUIRE((x - y).ordinalIndex() == (u - v).ordinalIndex());
+        REQUIRE((x * y).ordinalIndex() == (u * v).ordinalIndex());
+      }
+    }
+  }
+
+  SECTION("power, inverse and division") {
+    constexpr MontgomeryRing three{3};
+    REQUIRE(three.pow(2) == 9);
+    REQUIRE((three ^ three) == 27);
+    REQUIRE(three * three.inverse() == MontgomeryRing::One());
+    REQUIRE(MontgomeryRing{27} / three == 9);
+  }
+}
+
+
+// The division based reference, 998 = 2^10 - 26 is of a special form.
+struct EvenRingTraits : public TestRingTraits {
+  using Reduction = CryptoCom::DivisionReduction;
+  static constexpr PrimaryType Order{998};
+};
+struct BarrettRingTraits : public EvenRingTraits {
+  using Reduction = CryptoCom::BarrettReduction;
+};
+using BarrettRing = CryptoCom::CyclicRing<BarrettRingTraits>;
+using EvenRing = CryptoCom::CyclicRing<EvenRingTraits>;
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(std::ostream& ostr, BarrettRing const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+} // namespace CryptoCom
+
+
+TEST_CASE("In cyclic rings with Barrett reduction") {
+  SECTION("multiplication agrees with the division based ring") {
+    for (int32_t a = 0; a < EvenRingTraits::Order; a += 37) {
+      for (int32_t b = 0; b < EvenRingTraits::Order; b += 13) {
+        BarrettRing const x{a}, y{b};
+        EvenRing const u{a}, v{b};
+        REQUIRE((x * y).ordinalIndex() == (u * v).ordinalIndex());
+        REQUIRE((x + y).ordinalIndex() == (u + v).ordinalIndex());
+        REQUIRE((x - y).ordinalIndex() == (u - v).ordinalIndex());
+      }
+    }
+  }
+
+  SECTION("the largest residues are reduced fully") {
+    constexpr BarrettRing minusOne{-1};
+    REQUIRE(minusOne * minusOne == 1);
+    REQUIRE(minusOne + minusOne == -2);
+  }
+}
+
+
+struct WideRingTraits {
+  using PrimaryType = int64_t;
+  using EscalationType = CryptoCom::UInt128;
+  using CoefficientType = int64_t;
+
+  static constexpr PrimaryType Order{9223372036854775783}; // 2^63 - 25
+  static constexpr PrimaryType Generator{5};
+  static constexpr PrimaryType AdditiveIdentity{0};
+  static constexpr PrimaryType MultiplicativeIdentity{1};
+};
+struct WideBarrettRingTraits : public WideRingTraits {
+  using Reduction = CryptoCom::BarrettReduction;
+};
+struct WideMontgomeryRingTraits : public WideRingTraits {
+  using Reduction = CryptoCom::MontgomeryReduction;
+};
+struct WidePrimeRingTraits : public WideMontgomeryRingTraits {
+  static constexpr bool PrimeOrder = true;
+};
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<WideBarrettRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<WideMontgomeryRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<WidePrimeRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+} // namespace CryptoCom
+
+
+TEST_CASE("In cyclic rings of a 63 bit prime order") {
+  using WideRing = CryptoCom::CyclicRing<WideRingTraits>;
+  using WideBarrettRing = CryptoCom::CyclicRing<WideBarrettRingTraits>;
+  using WideMontgomeryRing = CryptoCom::CyclicRing<WideMontgomeryRingTraits>;
+
+  int64_t const samples[] = {1,
+      2,
+      0x7fffffff,
+      0x123456789abcdef,
+      WideRingTraits::Order / 2,
+      WideRingTraits::Order - 2,
+      WideRingTraits::Order - 1};
+
+  SECTION("products are reduced in 128 bits by every kernel") {
+    for (auto const a : samples) {
+      for (auto const b : samples) {
+        auto const expected = int64_t(
+            CryptoCom::UInt128(a) * CryptoCom::UInt128(b) %
+            CryptoCom::UInt128(WideRingTraits::Order));
+        CHECK((WideRing{a} * WideRing{b}).ordinalIndex() == expected);
+        CHECK((WideBarrettRing{a} * WideBarrettRing{b}).ordinalIndex() ==
+              expected);
+        CHECK((WideMontgomeryRing{a} * WideMontgomeryRing{b}).ordinalIndex() ==
+              expected);
+      }
+    }
+  }
+
+  SECTION("sums of the largest residues don't overflow") {
+    constexpr WideMontgomeryRing minusOne{-1};
+    REQUIRE((minusOne + minusOne).ordinalIndex() == WideRingTraits::Order - 2);
+    REQUIRE((WideRing{1} - WideRing{2}).ordinalIndex() ==
+            WideRingTraits::Order - 1);
+  }
+
+  SECTION("sliding window powers agree with square and multiply") {
+    auto const reference = [](int64_t const base, uint64_t exponent) {
+      CryptoCom::UInt128 const order = WideRingTraits::Order;
+      CryptoCom::UInt128 result = 1, power = base;
+      for (; exponent != 0; exponent >>= 1) {
+        if (exponent & 1)
+          result = result * power % order;
+        power = power * power % order;
+      }
+      return int64_t(result);
+    };
+
+    // Exponents of every length, so that every window width is used, with
+    // runs of zeros and ones both inside and at the ends of the windows.
+    uint64_t const patterns[] = {0x1, 0x5, 0x7f, 0x8001, 0xf0f0f0f,
+        0x123456789abcdef, 0x8000000000000001, 0xffffffffffffffff};
+    for (auto const a : samples) {
+      for (auto const pattern : patterns) {
+        for (int shift = 0; shift < 64; shift += 7) {
+          auto const exponent = pattern >> shift;
+          CHECK(WideMontgomeryRing{a}.pow(exponent).ordinalIndex() ==
+                reference(a, exponent));
+        }
+      }
+    }
+  }
+
+  SECTION("constant exponents unroll into addition chains") {
+    static_assert(CryptoCom::detail::AdditionChain<65537>::Value.cost() == 17,
+        "2^16 + 1 takes sixteen squarings and a multiplication");
+    static_assert(CryptoCom::detail::AdditionChain<0xffffffffffffffff>::Value
+                          .cost() < 63 + 63,
+        "windows save most multiplications of a run of ones");
+
+    for (auto const a : samples) {
+      WideMontgomeryRing const x{a};
+      REQUIRE(x.pow<0>().ordinalIndex() == 1);
+      REQUIRE(x.pow<1>().ordinalIndex() == x.ordinalIndex());
+      REQUIRE(x.pow<3>().ordinalIndex() == x.pow(3).ordinalIndex());
+      REQUIRE(x.pow<65537>().ordinalIndex() == x.pow(65537).ordinalIndex());
+      REQUIRE(x.pow<0x8000000000000001>().ordinalIndex() ==
+              x.pow(uint64_t{0x8000000000000001}).ordinalIndex());
+      REQUIRE(x.pow<0xffffffffffffffff>().ordinalIndex() ==
+              x.pow(uint64_t{0xffffffffffffffff}).ordinalIndex());
+      REQUIRE(x.pow<WideRingTraits::Order - 2>().ordinalIndex() ==
+              x.pow(WideRingTraits::Order - 2).ordinalIndex());
+    }
+  }
+
+  SECTION("Fermat's little theorem holds") {
+    for (auto const a : samples) {
+      REQUIRE(WideMontgomeryRing{a}.pow(WideRingTraits::Order - 1) ==
+              WideMontgomeryRing::One());
+      REQUIRE(WideBarrettRing{a}.pow(WideRingTraits::Order - 1) ==
+              WideBarrettRing::One());
+    }
+  }
+
+  SECTION("inverses by Fermat's little theorem agree with Euclid's") {
+    using WidePrimeRing = CryptoCom::CyclicRing<WidePrimeRingTraits>;
+    for (auto const a : samples) {
+      auto const inverse = WidePrimeRing{a}.inverse();
+      REQUIRE(inverse * WidePrimeRing{a} == WidePrimeRing::One());
+      REQUIRE(inverse.ordinalIndex() ==
+              WideMontgomeryRing{a}.inverse().ordinalIndex());
+    }
+    REQUIRE_THROWS_AS(
+        WidePrimeRing::Zero().inverse(), std::invalid_argument const&);
+  }
+}
+
+
+// 2^32 - 5, whose residues all fit into 32 bits.
+struct CompactRingTraits {
+  using PrimaryType = int64_t;
+  using EscalationType = CryptoCom::UInt128;
+  using CoefficientType = int64_t;
+  using StorageType = uint32_t;
+
+  static constexpr PrimaryType Order{4294967291};
+  static constexpr PrimaryType Generator{2};
+  static constexpr PrimaryType AdditiveIdentity{0};
+  static constexpr PrimaryType MultiplicativeIdentity{1};
+};
+struct CompactMontgomeryRingTraits : public CompactRingTraits {
+  using Reduction = CryptoCom::MontgomeryReduction;
+};
+struct CompactBarrettRingTraits : public CompactRingTraits {
+  using Reduction = CryptoCom::BarrettReduction;
+};
+struct UncompactRingTraits {
+  using PrimaryType = int64_t;
+  using EscalationType = CryptoCom::UInt128;
+  using CoefficientType = int64_t;
+  using Reduction = CryptoCom::DivisionReduction;
+
+  static constexpr PrimaryType Order{CompactRingTraits::Order};
+  static constexpr PrimaryType Generator{2};
+  static constexpr PrimaryType AdditiveIdentity{0};
+  static constexpr PrimaryType MultiplicativeIdentity{1};
+};
+
+
+TEST_CASE("In cyclic rings with a compact StorageType") {
+  using CompactRing = CryptoCom::CyclicRing<CompactRingTraits>;
+  using CompactMontgomeryRing =
+      CryptoCom::CyclicRing<CompactMontgomeryRingTraits>;
+  using CompactBarrettRing = CryptoCom::CyclicRing<CompactBarrettRingTraits>;
+  using Ring = CryptoCom::CyclicRing<UncompactRingTraits>;
+
+  static_assert(sizeof(CompactRing) == sizeof(uint32_t) &&
+                    sizeof(CompactMontgomeryRing) == sizeof(uint32_t) &&
+                    sizeof(CompactBarrettRing) == sizeof(uint32_t),
+      "elements are kept in the StorageType");
+
+  int64_t const samples[] = {0, 1, 2, 0x7fffffff, 0x80000000, 0xdeadbeef,
+      CompactRingTraits::Order - 2, CompactRingTraits::Order - 1,
+      -1, int64_t(1) << 40};
+
+  SECTION("arithmetic widens to the PrimaryType and back") {
+    for (auto const a : samples) {
+      for (auto const b : samples) {
+        auto const product = (Ring{a} * Ring{b}).ordinalIndex();
+        REQUIRE((CompactRing{a} * CompactRing{b}).ordinalIndex() == product);
+        REQUIRE((CompactMontgomeryRing{a} * CompactMontgomeryRing{b})
+                    .ordinalIndex() == product);
+        REQUIRE((CompactBarrettRing{a} * CompactBarrettRing{b})
+                    .ordinalIndex() == product);
+        REQUIRE((CompactMontgomeryRing{a} + CompactMontgomeryRing{b})
+                    .ordinalIndex() == (Ring{a} + Ring{b}).ordinalIndex());
+        REQUIRE((CompactRing{a} - CompactRing{b}).ordinalIndex() ==
+                (Ring{a} - Ring{b}).ordinalIndex());
+      }
+    }
+  }
+
+  SECTION("powers and inverses agree with the wide ring") {
+    for (auto const a : samples) {
+      REQUIRE(CompactMontgomeryRing{a}.pow(a).ordinalIndex() ==
+              Ring{a}.pow(a).ordinalIndex());
+      REQUIRE(CompactRing::GeneratorPow(a).ordinalIndex() ==
+              Ring::GeneratorPow(a).ordinalIndex());
+      if (Ring{a} != Ring::Zero()) {
+        REQUIRE(CompactMontgomeryRing{a}.inverse().ordinalIndex() ==
+                Ring{a}.inverse().ordinalIndex());
+      }
+    }
+
+    CompactMontgomeryRing sum;
+    for (auto const a : samples)
+      sum += CompactMontgomeryRing{a};
+    Ring expected;
+    for (auto const a : samples)
+      expected += Ring{a};
+    REQUIRE(sum.ordinalIndex() == expected.ordinalIndex());
+  }
+}
+
+
+// A 62 bit prime p = k q + 1 with the subgroup of the prime q = 2^31 - 1,
+// generated by 2^k.
+struct SchnorrGroupTraits {
+  using PrimaryType = int64_t;
+  using EscalationType = CryptoCom::UInt128;
+  using CoefficientType = int64_t;
+  using Reduction = CryptoCom::MontgomeryReduction;
+
+  static constexpr PrimaryType Order{2305843201413480359};
+  static constexpr PrimaryType SubgroupOrder{2147483647};
+  static constexpr PrimaryType Generator{157608736213706629};
+  static constexpr PrimaryType AdditiveIdentity{0};
+  static constexpr PrimaryType MultiplicativeIdentity{1};
+  static constexpr bool PrimeOrder = true;
+};
+
+
+TEST_CASE("In Schnorr groups") {
+  using Ring = CryptoCom::CyclicRing<SchnorrGroupTraits>;
+  int64_t constexpr q = SchnorrGroupTraits::SubgroupOrder;
+
+  static_assert(CryptoCom::detail::OrderBits<SchnorrGroupTraits>::value == 31,
+      "tables cover exponents below the subgroup order only");
+  REQUIRE(Ring::Generator().pow(q).ordinalIndex() == 1);
+
+  SECTION("ring elements are reduced modulo the subgroup order as exponents") {
+    REQUIRE(Ring{q + 5}.exponent() == 5);
+    REQUIRE(Ring{q - 1}.exponent() == q - 1);
+    REQUIRE(Ring{-1}.exponent() == (SchnorrGroupTraits::Order - 1) % q);
+  }
+
+  SECTION("powers of the subgroup's elements agree with the full exponent") {
+    auto const key = Ring::GeneratorPow(int64_t{123456789});
+    Ring::FixedBase<> const prepared{key};
+    int64_t const exponents[] = {0, 1, q - 1, q, q + 1, 0x7123456789abcdef,
+        SchnorrGroupTraits::Order - 1};
+    for (auto const e : exponents) {
+      Ring const exponent{e};
+      auto const expected = key.pow(exponent.ordinalIndex()).ordinalIndex();
+      REQUIRE(key.pow(exponent).ordinalIndex() == expected);
+      REQUIRE(prepared.pow(exponent).ordinalIndex() == expected);
+      REQUIRE(Ring::GeneratorPow(exponent).ordinalIndex() ==
+              Ring::Generator().pow(exponent.ordinalIndex()).ordinalIndex());
+    }
+  }
+
+  SECTION("elements outside the subgroup still invert") {
+    Ring const a{2};
+    REQUIRE(a.pow(q).ordinalIndex() != 1);
+    REQUIRE((a * a.inverse()).ordinalIndex() == 1);
+  }
+}
@@ -0,0 +1,263 @@
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/ElGamal.hpp>
+#include <CryptoCom/ExponentialElGamal.hpp>
+#include <CryptoCom/ObliviousEvaluation.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+#include <set>
+#include <stdexcept>
+
+
+namespace {
+  struct WordGroup : CryptoCom::DynamicRingTraits<WordGroup, int64_t,
+                        CryptoCom::UInt128, int64_t> {};
+  struct SmallGroup
+      : CryptoCom::DynamicRingTraits<SmallGroup, int32_t, int64_t, int32_t> {};
+  struct LimbGroup : CryptoCom::DynamicRingTraits<LimbGroup,
+                         CryptoCom::FixedUInt<256>, CryptoCom::FixedUInt<512>,
+                         CryptoCom::FixedInt<320>> {};
+  struct CompactGroup : CryptoCom::DynamicRingTraits<CompactGroup, int64_t,
+                           CryptoCom::UInt128, int64_t> {
+    using StorageType = uint32_t;
+  };
+  struct UninstalledGroup
+      : CryptoCom::DynamicRingTraits<UninstalledGroup, int32_t, int64_t,
+            int32_t> {};
+
+
+  struct WideRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    static constexpr PrimaryType Order{9223372036854775783}; // 2^63 - 25
+    static constexpr PrimaryType Generator{5};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct EvenRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int32_t;
+
+    static constexpr PrimaryType Order{998};
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct LimbRingTraits {
+    using PrimaryType = CryptoCom::FixedUInt<256>;
+    using EscalationType = CryptoCom::FixedUInt<512>;
+    using CoefficientType = CryptoCom::FixedInt<320>;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    // 2^255 - 19
+    static constexpr PrimaryType Order = PrimaryType::FromHex(
+        "7fffffffffffffff'ffffffffffffffff'ffffffffffffffff'ffffffffffffffed");
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::Order;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::Generator;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::AdditiveIdentity;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::MultiplicativeIdentity;
+} // namespace
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<WordGroup> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<SmallGroup> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<LimbGroup> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+} // namespace CryptoCom
+
+
+TEST_CASE("In cyclic rings of an order chosen at run time") {
+  std::mt19937_64 engine;
+
+  SECTION("odd orders agree with the compile time Montgomery form") {
+    using Ring = CryptoCom::DynamicCyclicRing<WordGroup>;
+    using StaticRing = CryptoCom::CyclicRing<WideRingTraits>;
+    CryptoCom::DynamicRingContext<WordGroup>::Install(
+        int64_t{WideRingTraits::Order}, int64_t{WideRingTraits::Generator});
+    REQUIRE(WordGroup::Order == int64_t{WideRingTraits::Order});
+
+    for (int idx = 0; idx < 100; ++idx) {
+      auto const a = int64_t(engine() >> 1);
+      auto const b = int64_t(engine() >> (1 + idx % 63));
+      REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+              (StaticRing{a} * StaticRing{b}).ordinalIndex());
+      REQUIRE((Ring{a} + Ring{b}).ordinalIndex() ==
+              (StaticRing{a} + StaticRing{b}).ordinalIndex());
+      REQUIRE((Ring{a} - Ring{b}).ordinalIndex() ==
+              (StaticRing{a} - StaticRing{b}).ordinalIndex());
+      REQUIRE((-Ring{b}).ordinalIndex() == (-StaticRing{b}).ordinalIndex());
+      REQUIRE(Ring{a}.pow(b).ordinalIndex() ==
+              StaticRing{a}.pow(b).ordinalIndex());
+      REQUIRE(Ring::GeneratorPow(b).ordinalIndex() ==
+              StaticRing::GeneratorPow(b).ordinalIndex());
+      REQUIRE(Ring{a} * Ring{a}.inverse() == Ring::One());
+    }
+  }
+
+  SECTION("even orders agree with the division based ring") {
+    using Ring = CryptoCom::DynamicCyclicRing<SmallGroup>;
+    using StaticRing = CryptoCom::CyclicRing<EvenRingTraits>;
+    CryptoCom::DynamicRingContext<SmallGroup>::Install(
+        int32_t{EvenRingTraits::Order}, int32_t{EvenRingTraits::Generator});
+
+    for (int32_t a = -EvenRingTraits::Order; a < EvenRingTraits::Order;
+         a += 37) {
+      for (int32_t b = 0; b < EvenRingTraits::Order; b += 13) {
+        REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+                (StaticRing{a} * StaticRing{b}).ordinalIndex());
+        REQUIRE((Ring{a} - Ring{b}).ordinalIndex() ==
+                (StaticRing{a} - StaticRing{b}).ordinalIndex());
+        REQUIRE(Ring::GeneratorPow(b).ordinalIndex() ==
+                StaticRing::GeneratorPow(b).ordinalIndex());
+      }
+    }
+    REQUIRE(Ring{-1} * Ring{-1} == 1);
+  }
+
+  SECTION("fixed width orders agree with the compile time Montgomery form") {
+    using Ring = CryptoCom::DynamicCyclicRing<LimbGroup>;
+    using StaticRing = CryptoCom::CyclicRing<LimbRingTraits>;
+    CryptoCom::DynamicRingContext<LimbGroup>::Install(
+        LimbRingTraits::Order, LimbRingTraits::Generator);
+
+    for (int idx = 0; idx < 10; ++idx) {
+      LimbRingTraits::PrimaryType a, b;
+      for (std::size_t limb = 0; limb < a.LimbCount; ++limb) {
+        a.data()[limb] = engine();
+        b.data()[limb] = engine();
+      }
+      REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+              (StaticRing{a} * StaticRing{b}).ordinalIndex());
+      REQUIRE((Ring{a} - Ring{b}).ordinalIndex() ==
+              (StaticRing{a} - StaticRing{b}).ordinalIndex());
+      REQUIRE(Ring{a}.square().ordinalIndex() ==
+              StaticRing{a}.square().ordinalIndex());
+      REQUIRE(Ring::GeneratorPow(b).ordinalIndex() ==
+              StaticRing::GeneratorPow(b).ordinalIndex());
+      REQUIRE(Ring{a} * Ring{a}.inverse() == Ring::One());
+    }
+  }
+
+  SECTION("installed groups can be switched between") {
+    using Ring = CryptoCom::DynamicCyclicRing<SmallGroup>;
+    using Context = CryptoCom::DynamicRingContext<SmallGroup>;
+    auto const small = Context::Install(37, 2);
+    REQUIRE(Ring{6} * Ring{7} == 5);
+
+    Context::Install(1483, 2);
+    REQUIRE(Ring{6} * Ring{7} == 42);
+    REQUIRE(Ring::Generator().pow(11) == 565);
+
+    Context::Install(small);
+    REQUIRE(SmallGroup::Order == 37);
+    REQUIRE(Ring{6} * Ring{7} == 5);
+    REQUIRE(Ring::GeneratorPow(5) == 32);
+  }
+
+  SECTION("compact groups keep their elements in the StorageType") {
+    using Ring = CryptoCom::DynamicCyclicRing<CompactGroup>;
+    using WideRing = CryptoCom::DynamicCyclicRing<WordGroup>;
+    using Context = CryptoCom::DynamicRingContext<CompactGroup>;
+    static_assert(sizeof(Ring) == sizeof(uint32_t), "stored in 32 bits");
+
+    Context::Install(4294967291, 2);
+    CryptoCom::DynamicRingContext<WordGroup>::Install(4294967291, 2);
+    for (int idx = 0; idx < 100; ++idx) {
+      auto const a = int64_t(engine() >> 1);
+      auto const b = int64_t(engine() >> (1 + idx % 63));
+      REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+              (WideRing{a} * WideRing{b}).ordinalIndex());
+      REQUIRE(Ring::GeneratorPow(b).ordinalIndex() ==
+              WideRing::GeneratorPow(b).ordinalIndex());
+    }
+
+    Context::Install(4294967296, 3);
+    REQUIRE(Ring{-1}.ordinalIndex() == 4294967295);
+    REQUIRE_THROWS_AS(
+        Context::Install(4294967298, 5), std::invalid_argument const&);
+  }
+
+  SECTION("orders which can't be reduced modulo are rejected") {
+    using SmallContext = CryptoCom::DynamicRingContext<SmallGroup>;
+    using LimbContext = CryptoCom::DynamicRingContext<LimbGroup>;
+    REQUIRE_THROWS_AS(
+        SmallContext::Install(1, 0), std::invalid_argument const&);
+    REQUIRE_THROWS_AS(
+        SmallContext::Install(-5, 2), std::invalid_argument const&);
+    REQUIRE_THROWS_AS(
+        LimbContext::Install(1024, 3), std::invalid_argument const&);
+  }
+
+  SECTION("groups without an installed context are rejected") {
+    using Context = CryptoCom::DynamicRingContext<UninstalledGroup>;
+    REQUIRE_THROWS_AS(Context::Current(), std::logic_error const&);
+  }
+}
+
+
+TEST_CASE("Encryption schemes over groups chosen at run time") {
+  CryptoCom::DynamicRingContext<SmallGroup>::Install(1483, 2);
+
+  SECTION("ElGamal encrypts as over the compile time group") {
+    using Ring = CryptoCom::DynamicCyclicRing<SmallGroup>;
+    using EncryptionScheme = CryptoCom::ElGamal<SmallGroup>;
+    Ring privateKey, publicKey;
+    std::tie(privateKey, publicKey) =
+        EncryptionScheme::KeyPairOf([]() { return Ring{5}; });
+    REQUIRE(publicKey == 32);
+
+    auto const cipher =
+        EncryptionScheme::Encrypt(publicKey, 2, []() { return Ring{3}; });
+    REQUIRE(cipher[0] == 8);
+    REQUIRE(cipher[1] == 284);
+    REQUIRE(EncryptionScheme::Decrypt(privateKey, cipher) == 2);
+  }
+
+  SECTION("private set intersection finds the common elements") {
+    using Ring = CryptoCom::DynamicCyclicRing<WordGroup>;
+    using Encryption = CryptoCom::ExponentialElGamal<WordGroup>;
+    using ClientSet =
+        CryptoCom::ObliviousEvaluation::ClientSet<Ring, int32_t, Encryption>;
+    using ServerSet =
+        CryptoCom::ObliviousEvaluation::ServerSet<Ring, int32_t, Encryption>;
+    CryptoCom::DynamicRingContext<WordGroup>::Install(1000003, 2);
+
+    std::mt19937_64 engine;
+    auto rng = [&engine]() { return Ring{int64_t(engine() >> 1)}; };
+    Ring privateKey, publicKey;
+    std::tie(privateKey, publicKey) = Encryption::KeyPairOf(rng);
+
+    ClientSet client{publicKey, privateKey, {2, 4, 6}, rng};
+    ServerSet server{{3, 6, 9}};
+    auto const evaluated = server.evaluate(client.forServer(), rng);
+    REQUIRE(client.intersection(evaluated, privateKey) ==
+            (std::set<int32_t>{6}));
+  }
+}
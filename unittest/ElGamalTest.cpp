@@ -1,6 +1,7 @@
 #include <CryptoCom/ElGamal.hpp>
 #include <catch/catch.hpp>
 #include <list>
+#include <vector>
 
 namespace {
 
@@ -81,5 +82,62 @@ TEST_CASE("ElGamal encryption scheme") {
           EncryptionScheme::Encrypt(publicKey, 96, sequenceFunction);
       REQUIRE(eight * twelve == ninetySix);
     }
+
+
+    SECTION("batch decryption agrees with decrypting one by one") {
+      std::vector<EncryptionScheme::Cipher> ciphers;
+      for (int32_t random = 1; random < 100; ++random) {
+        ciphers.push_back(EncryptionScheme::Encrypt(
+            publicKey, random * 13, [random]() { return Ring{random}; }));
+      }
+
+      auto const plainTexts = EncryptionScheme::DecryptBatch(
+          privateKey, ciphers.cbegin(), ciphers.cend());
+      REQUIRE(plainTexts.size() == ciphers.size());
+      for (std::size_t idx = 0; idx < ciphers.size(); ++idx) {
+        REQUIRE(plainTexts[idx] ==
+                EncryptionScheme::Decrypt(privateKey, ciphers[idx]));
+      }
+    }
+
+
+    SECTION("batch encryption agrees with encrypting one by one") {
+      std::vector<Ring> plainTexts;
+      for (int32_t message = 1; message < 100; ++message)
+        plainTexts.push_back(message * 7);
+
+      int32_t random = 0;
+      auto const ciphers = EncryptionScheme::EncryptBatch(publicKey,
+          plainTexts.cbegin(), plainTexts.cend(),
+          [&random]() { return Ring{++random * 11}; });
+      REQUIRE(ciphers.size() == plainTexts.size());
+      for (std::size_t idx = 0; idx < ciphers.size(); ++idx) {
+        auto const expected = EncryptionScheme::Encrypt(publicKey,
+            plainTexts[idx], [idx]() { return Ring{int32_t(idx + 1) * 11}; });
+        REQUIRE(ciphers[idx] == expected);
+      }
+
+      random = 0;
+      CryptoCom::PreparedPublicKey<RingTraits, 3> const prepared{publicKey};
+      REQUIRE(EncryptionScheme::EncryptBatch(prepared, plainTexts.cbegin(),
+                  plainTexts.cend(),
+                  [&random]() { return Ring{++random * 11}; }) == ciphers);
+    }
+
+
+    SECTION("a prepared public key encrypts like the raw key") {
+      CryptoCom::PreparedPublicKey<RingTraits> const prepared{publicKey};
+      CryptoCom::PreparedPublicKey<RingTraits, 1> const narrow{publicKey};
+      CryptoCom::PreparedPublicKey<RingTraits, 7> const wide{publicKey};
+      REQUIRE(prepared.key() == publicKey);
+
+      for (int32_t random = 0; random < RingTraits::Order; random += 7) {
+        auto const rng = [random]() { return Ring{random}; };
+        auto const expected = EncryptionScheme::Encrypt(publicKey, 2, rng);
+        REQUIRE(EncryptionScheme::Encrypt(prepared, 2, rng) == expected);
+        REQUIRE(EncryptionScheme::Encrypt(narrow, 2, rng) == expected);
+        REQUIRE(EncryptionScheme::Encrypt(wide, 2, rng) == expected);
+      }
+    }
   }
 }
@@ -0,0 +1,142 @@
+#include <CryptoCom/Eucledian.hpp>
+#include <CryptoCom/FixedInteger.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+#include <stdexcept>
+#include <tuple>
+
+
+namespace {
+  using UInt128 = CryptoCom::UInt128;
+  using Fixed256 = CryptoCom::FixedUInt<256>;
+  using Coefficient = CryptoCom::FixedInt<320>;
+  using Wide = CryptoCom::FixedInt<640>;
+
+
+  Fixed256 RandomFixed(std::mt19937_64& engine, int const shift) {
+    Fixed256 result;
+    for (std::size_t limb = 0; limb < result.LimbCount; ++limb)
+      result.data()[limb] = engine();
+    return (result >> 1) >> shift;
+  }
+
+
+  // Checks g = a x + b y and that g divides both a and b.
+  void RequireBezout(Fixed256 const& a, Fixed256 const& b) {
+    Fixed256 g;
+    Coefficient x, y;
+    std::tie(g, x, y) = CryptoCom::ExtendedGCD<Fixed256, Coefficient>(a, b);
+
+    REQUIRE(Wide(a) * Wide(x) + Wide(b) * Wide(y) == Wide(g));
+    REQUIRE(a % g == 0);
+    REQUIRE(b % g == 0);
+  }
+} // namespace
+
+
+TEST_CASE("Extended Euclidean algorithm") {
+  std::mt19937_64 engine;
+
+  SECTION("finds Bezout coefficients of word sized integers") {
+    for (int idx = 0; idx < 1000; ++idx) {
+      auto const a = int64_t(engine() >> (1 + idx % 62));
+      auto const b = int64_t(engine() >> (1 + idx % 31));
+      int64_t g, x, y;
+      std::tie(g, x, y) = CryptoCom::ExtendedGCD<int64_t, int64_t>(a, b);
+
+      REQUIRE(uint64_t(a) * uint64_t(x) + uint64_t(b) * uint64_t(y) ==
+              uint64_t(g));
+      REQUIRE(a % g == 0);
+      REQUIRE(b % g == 0);
+    }
+  }
+
+  SECTION("keeps the results of the recursive definition on zero") {
+    REQUIRE((CryptoCom::ExtendedGCD<int32_t, int32_t>(0, 7) ==
+             std::make_tuple(7, 0, 1)));
+    REQUIRE((CryptoCom::ExtendedGCD<int32_t, int32_t>(7, 0) ==
+             std::make_tuple(7, 1, 0)));
+  }
+
+  SECTION("finds Bezout coefficients of multi-precision integers") {
+    for (int idx = 0; idx < 200; ++idx)
+      RequireBezout(
+          RandomFixed(engine, idx % 7), RandomFixed(engine, idx % 200));
+  }
+
+  SECTION("finds common factors of multi-precision integers") {
+    for (int idx = 0; idx < 50; ++idx) {
+      auto const factor = RandomFixed(engine, 128 + idx);
+      auto const a = factor * RandomFixed(engine, 140);
+      auto const b = factor * RandomFixed(engine, 128 - idx);
+      RequireBezout(a, b);
+
+      Fixed256 g;
+      std::tie(g, std::ignore, std::ignore) =
+          CryptoCom::ExtendedGCD<Fixed256, Coefficient>(a, b);
+      REQUIRE(g % factor == 0);
+    }
+  }
+
+  SECTION("agrees with a single step on equal and consecutive integers") {
+    auto const a = RandomFixed(engine, 0);
+    RequireBezout(a, a);
+    RequireBezout(a, a + 1);
+    RequireBezout(a, Fixed256(0));
+    RequireBezout(Fixed256(1), a);
+  }
+}
+
+
+TEST_CASE("Inverse modulo") {
+  std::mt19937_64 engine;
+
+  SECTION("of an odd word sized modulus") {
+    int64_t const modulus = 9223372036854775783; // 2^63 - 25
+    for (int idx = 0; idx < 1000; ++idx) {
+      auto const a = int64_t(engine() % uint64_t(modulus - 1)) + 1;
+      auto const inverse =
+          CryptoCom::InverseModulo<int64_t, int64_t>(a, modulus);
+      REQUIRE(inverse >= 0);
+      REQUIRE(inverse < modulus);
+      auto const product = UInt128(a) * UInt128(inverse);
+      REQUIRE(uint64_t(product % UInt128(modulus)) == 1);
+    }
+  }
+
+  SECTION("of an even word sized modulus") {
+    for (int32_t a = 1; a < 998; a += 2) {
+      if (a % 499 == 0)
+        continue;
+      auto const inverse = CryptoCom::InverseModulo<int32_t, int32_t>(a, 998);
+      REQUIRE(a * inverse % 998 == 1);
+    }
+  }
+
+  SECTION("of relative primes only") {
+    REQUIRE_THROWS_AS((CryptoCom::InverseModulo<int32_t, int32_t>(0, 37)),
+        std::invalid_argument const&);
+    REQUIRE_THROWS_AS((CryptoCom::InverseModulo<int32_t, int32_t>(21, 35)),
+        std::invalid_argument const&);
+    REQUIRE_THROWS_AS((CryptoCom::InverseModulo<int32_t, int32_t>(4, 998)),
+        std::invalid_argument const&);
+    REQUIRE_THROWS_AS(
+        (CryptoCom::InverseModulo<Fixed256, Coefficient>(6, 1024)),
+        std::invalid_argument const&);
+  }
+
+  SECTION("of a multi-precision modulus") {
+    // 2^255 - 19
+    auto const modulus = Fixed256::FromHex(
+        "7fffffffffffffff'ffffffffffffffff'ffffffffffffffff'ffffffffffffffed");
+    for (int idx = 0; idx < 100; ++idx) {
+      auto const a = RandomFixed(engine, idx) % modulus;
+      auto const inverse =
+          CryptoCom::InverseModulo<Fixed256, Coefficient>(a, modulus);
+      REQUIRE(inverse < modulus);
+      using Fixed512 = CryptoCom::FixedUInt<512>;
+      REQUIRE(Fixed512(a) * Fixed512(inverse) % Fixed512(modulus) == 1);
+    }
+  }
+}
@@ -73,6 +73,23 @@ TEST_CASE("The exponential ElGamal encryption scheme") {
     }
 
 
+    SECTION("batch encryption agrees with encrypting one by one") {
+      std::list<int32_t> const plainTexts{2, 4, 6, 8};
+      auto const ciphers = ExpElGamal::EncryptBatch(public_key,
+          plainTexts.cbegin(), plainTexts.cend(), []() { return Ring{3}; });
+      REQUIRE(ciphers.front() == ExpElGamal::Cipher(Ring{8}, Ring{568}));
+
+      auto cipher = ciphers.cbegin();
+      for (auto const plainText : plainTexts) {
+        REQUIRE(*cipher++ == ExpElGamal::Encrypt(public_key, plainText,
+                                 []() { return Ring{3}; }));
+      }
+      auto const decrypted = ExpElGamal::DecryptBatch(
+          private_key, ciphers.cbegin(), ciphers.cend());
+      REQUIRE(decrypted[3] == ExpElGamal::Decipher(8));
+    }
+
+
     SECTION("encryption is homomorphic to") {
       Ring const eight{8};
       Ring const twelve{12};
@@ -98,9 +115,9 @@ TEST_CASE("The exponential ElGamal encryption scheme") {
 
       SECTION("adding a number and its negative, so it results in zero") {
         seq = {3, 6, 9};
-        auto const cipher_one = ExpElGamal::Encrypt(private_key, 1, rng);
+        auto const cipher_one = ExpElGamal::Encrypt(public_key, 1, rng);
         auto const cipher_minus_one = ExpElGamal::Encrypt(public_key, -1, rng);
-        auto const cipher_zero = ExpElGamal::Encrypt(private_key, 0, rng);
+        auto const cipher_zero = ExpElGamal::Encrypt(public_key, 0, rng);
         REQUIRE(cipher_one + cipher_minus_one == cipher_zero);
       }
 
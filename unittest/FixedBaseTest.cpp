@@ -0,0 +1,128 @@
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/ExponentialElGamal.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+
+
+namespace {
+  struct SmallRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int32_t;
+
+    static constexpr PrimaryType Order{1000003};
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct WordRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    static constexpr PrimaryType Order{9223372036854775783}; // 2^63 - 25
+    static constexpr PrimaryType Generator{5};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct LimbRingTraits {
+    using PrimaryType = CryptoCom::FixedUInt<256>;
+    using EscalationType = CryptoCom::FixedUInt<512>;
+    using CoefficientType = CryptoCom::FixedInt<320>;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    // 2^255 - 19
+    static constexpr PrimaryType Order = PrimaryType::FromHex(
+        "7fffffffffffffff'ffffffffffffffff'ffffffffffffffff'ffffffffffffffed");
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::Order;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::Generator;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::AdditiveIdentity;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::MultiplicativeIdentity;
+} // namespace
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<SmallRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<WordRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<LimbRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+} // namespace CryptoCom
+
+
+TEST_CASE("Fixed-base powers of the generator") {
+  std::mt19937_64 engine;
+
+  SECTION("agree with generic exponentiation for every short exponent") {
+    using Ring = CryptoCom::CyclicRing<SmallRingTraits>;
+    for (int32_t exponent = -300; exponent < 300; ++exponent)
+      REQUIRE(Ring::GeneratorPow(exponent) == Ring::Generator().pow(exponent));
+  }
+
+  SECTION("cover exponents up to the order and beyond") {
+    using Ring = CryptoCom::CyclicRing<SmallRingTraits>;
+    REQUIRE(Ring::GeneratorPow(SmallRingTraits::Order - 1) ==
+            Ring::Generator().pow(SmallRingTraits::Order - 1));
+    REQUIRE(Ring::GeneratorPow(Ring{-1}) ==
+            Ring::Generator().pow(SmallRingTraits::Order - 1));
+    REQUIRE(Ring::GeneratorPow(int64_t(1) << 40) ==
+            Ring::Generator().pow(int64_t(1) << 40));
+  }
+
+  SECTION("agree with generic exponentiation in Montgomery form") {
+    using Ring = CryptoCom::CyclicRing<WordRingTraits>;
+    for (int idx = 0; idx < 100; ++idx) {
+      auto const exponent = Ring{int64_t(engine() >> 1)};
+      REQUIRE(Ring::GeneratorPow(exponent) == Ring::Generator().pow(exponent));
+    }
+  }
+
+  SECTION("agree with generic exponentiation over fixed width integers") {
+    using Ring = CryptoCom::CyclicRing<LimbRingTraits>;
+    for (int idx = 0; idx < 10; ++idx) {
+      LimbRingTraits::PrimaryType exponent;
+      for (std::size_t limb = 0; limb < exponent.LimbCount; ++limb)
+        exponent.data()[limb] = engine();
+      exponent = exponent >> idx;
+      REQUIRE(Ring::GeneratorPow(exponent) == Ring::Generator().pow(exponent));
+      REQUIRE(Ring::GeneratorPow(uint32_t(exponent)) ==
+              Ring::Generator().pow(uint32_t(exponent)));
+    }
+  }
+
+  SECTION("exponential ElGamal adds plain texts through the table") {
+    using Ring = CryptoCom::CyclicRing<SmallRingTraits>;
+    using EncryptionScheme = CryptoCom::ExponentialElGamal<SmallRingTraits>;
+    Ring privateKey, publicKey;
+    std::tie(privateKey, publicKey) =
+        EncryptionScheme::KeyPairOf([]() { return Ring{4242}; });
+
+    auto const cipher =
+        EncryptionScheme::Encrypt(publicKey, -5, []() { return Ring{77}; });
+    REQUIRE(EncryptionScheme::Decrypt(privateKey, cipher + Ring{12}) ==
+            EncryptionScheme::Decipher(7));
+  }
+}
@@ -0,0 +1,148 @@
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/ElGamal.hpp>
+#include <CryptoCom/FixedInteger.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+#include <sstream>
+
+
+namespace {
+  using UInt128 = CryptoCom::UInt128;
+  using Fixed128 = CryptoCom::FixedUInt<128>;
+  using Fixed256 = CryptoCom::FixedUInt<256>;
+
+
+  Fixed128 FromUInt128(UInt128 const value) {
+    return (Fixed128(uint64_t(value >> 64)) << 64) | Fixed128(uint64_t(value));
+  }
+
+
+  struct BigRingTraits {
+    using PrimaryType = CryptoCom::FixedUInt<256>;
+    using EscalationType = CryptoCom::FixedUInt<512>;
+    using CoefficientType = CryptoCom::FixedInt<320>;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    // 2^255 - 19
+    static constexpr PrimaryType Order = PrimaryType::FromHex(
+        "7fffffffffffffff'ffffffffffffffff'ffffffffffffffff'ffffffffffffffed");
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr BigRingTraits::PrimaryType BigRingTraits::Order;
+  constexpr BigRingTraits::PrimaryType BigRingTraits::Generator;
+  constexpr BigRingTraits::PrimaryType BigRingTraits::AdditiveIdentity;
+  constexpr BigRingTraits::PrimaryType BigRingTraits::MultiplicativeIdentity;
+
+
+  struct BigDivisionRingTraits : public BigRingTraits {
+    using Reduction = CryptoCom::DivisionReduction;
+  };
+} // namespace
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<BigRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+} // namespace CryptoCom
+
+
+TEST_CASE("Fixed width integers") {
+  std::mt19937_64 engine;
+  auto random128 = [&engine]() {
+    return (UInt128(engine()) << 64) | engine();
+  };
+
+  SECTION("arithmetic agrees with the built-in 128 bit integers") {
+    for (int idx = 0; idx < 200; ++idx) {
+      auto const a = random128();
+      auto const b = random128() >> (idx % 128);
+      auto const x = FromUInt128(a), y = FromUInt128(b);
+      REQUIRE(x + y == FromUInt128(a + b));
+      REQUIRE(x - y == FromUInt128(a - b));
+      REQUIRE(x * y == FromUInt128(a * b));
+      if (b != 0) {
+        REQUIRE(x / y == FromUInt128(a / b));
+        REQUIRE(x % y == FromUInt128(a % b));
+      }
+      REQUIRE(x << (idx % 128) == FromUInt128(a << (idx % 128)));
+      REQUIRE(x >> (idx % 128) == FromUInt128(a >> (idx % 128)));
+      REQUIRE((x < y) == (a < b));
+    }
+  }
+
+  SECTION("multi-limb division is the inverse of multiplication") {
+    for (int idx = 0; idx < 100; ++idx) {
+      Fixed256 const quotient{FromUInt128(random128())};
+      Fixed256 const divisor{FromUInt128(random128() >> (idx % 100))};
+      Fixed256 const remainder = Fixed256{FromUInt128(random128())} % divisor;
+      auto const dividend = quotient * divisor + remainder;
+      REQUIRE(dividend / divisor == quotient);
+      REQUIRE(dividend % divisor == remainder);
+    }
+  }
+
+  SECTION("signed integers divide towards zero and extend their sign") {
+    using Int = CryptoCom::FixedInt<192>;
+    REQUIRE(Int{-7} / Int{2} == Int{-3});
+    REQUIRE(Int{-7} % Int{2} == Int{-1});
+    REQUIRE(Int{7} / Int{-2} == Int{-3});
+    REQUIRE(Int{-1} < Int{0});
+    REQUIRE((Int{-8} >> 2) == Int{-2});
+    REQUIRE(Fixed256{Int{-1}} == ~Fixed256{});
+    REQUIRE(Int{Fixed128{5}} - Int{6} == Int{-1});
+  }
+
+  SECTION("hexadecimal constants are parsed at compile time") {
+    constexpr auto value = Fixed256::FromHex("0x1'0000000000000000'0000000f");
+    static_assert(value.data()[0] == 0xf, "lowest limb");
+    static_assert(value.data()[1] == 0x100000000, "second limb");
+
+    std::ostringstream ostr;
+    ostr << value;
+    REQUIRE(ostr.str() == "0x100000000000000000000000f");
+  }
+}
+
+
+TEST_CASE("Cyclic rings over fixed width integers") {
+  using BigRing = CryptoCom::CyclicRing<BigRingTraits>;
+  using BigDivisionRing = CryptoCom::CyclicRing<BigDivisionRingTraits>;
+
+  auto const a = BigRingTraits::PrimaryType::FromHex(
+      "123456789abcdef0fedcba9876543210'0f1e2d3c4b5a69788796a5b4c3d2e1f0");
+  auto const b = BigRingTraits::Order - 12345;
+
+  SECTION("Montgomery multiplication agrees with division") {
+    REQUIRE((BigRing{a} * BigRing{b}).ordinalIndex() ==
+            (BigDivisionRing{a} * BigDivisionRing{b}).ordinalIndex());
+    REQUIRE((BigRing{a} - BigRing{b}).ordinalIndex() ==
+            (BigDivisionRing{a} - BigDivisionRing{b}).ordinalIndex());
+  }
+
+  SECTION("Fermat's little theorem holds") {
+    REQUIRE(BigRing{a}.pow(BigRingTraits::Order - 1) == BigRing::One());
+  }
+
+  SECTION("multiplication with multiplicative inverse is identity") {
+    REQUIRE(BigRing{a} * BigRing{a}.inverse() == BigRing::One());
+    REQUIRE(BigRing{b} / BigRing{b} == 1);
+  }
+
+  SECTION("ElGamal encryption round trips") {
+    using EncryptionScheme = CryptoCom::ElGamal<BigRingTraits>;
+    BigRing privateKey, publicKey;
+    std::tie(privateKey, publicKey) =
+        EncryptionScheme::KeyPairOf([&a]() { return BigRing{a}; });
+
+    auto const cipher = EncryptionScheme::Encrypt(
+        publicKey, 42, [&b]() { return BigRing{b}; });
+    REQUIRE(EncryptionScheme::Decrypt(privateKey, cipher) == 42);
+  }
+}
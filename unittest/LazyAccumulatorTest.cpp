@@ -0,0 +1,117 @@
+#include <CryptoCom/LazyAccumulator.hpp>
+#include <CryptoCom/Polynomial.hpp>
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace {
+  struct SmallRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{1483};
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  template <typename ReductionTag>
+  struct WideRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = ReductionTag;
+
+    static constexpr PrimaryType Order{4611686018427387847}; // 2^62 - 57
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  template <typename ReductionTag>
+  constexpr int64_t WideRingTraits<ReductionTag>::Order;
+
+
+  struct EvenRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::BarrettReduction;
+
+    static constexpr PrimaryType Order{2250635938};
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  using DivisionTraits = WideRingTraits<CryptoCom::DivisionReduction>;
+  using MontgomeryTraits = WideRingTraits<CryptoCom::MontgomeryReduction>;
+  using SpecialFormTraits = WideRingTraits<CryptoCom::SpecialFormReduction>;
+
+  static_assert(CryptoCom::detail::LazyHeadroom<DivisionTraits>::value == 16,
+      "2^128 / (2^62 - 58)^2 products fit into the double word");
+  static_assert(CryptoCom::detail::LazyHeadroom<MontgomeryTraits>::value == 4,
+      "REDC takes sums below Order * 2^64");
+  static_assert(CryptoCom::detail::LazyHeadroom<EvenRingTraits>::value == 3,
+      "Barrett reduction takes sums below 4^32");
+
+
+  template <typename Traits>
+  void CheckAgainstEagerSums(std::mt19937_64& engine) {
+    using Ring = CryptoCom::CyclicRing<Traits>;
+    for (std::size_t count : {0, 1, 2, 3, 4, 5, 16, 17, 100}) {
+      CryptoCom::LazyAccumulator<Ring> lazy;
+      auto eager = Ring::Zero();
+      for (std::size_t idx = 0; idx < count; ++idx) {
+        // Mostly the largest residues, to push the headroom to its limit.
+        using Primary = typename Traits::PrimaryType;
+        Ring const lhs{idx % 2 == 0 ? Primary(Traits::Order - 1)
+                                    : Primary(engine() % Traits::Order)};
+        Ring const rhs{Primary(Traits::Order - 1 - Primary(idx % 3))};
+        lazy.add(lhs, rhs);
+        eager = eager + lhs * rhs;
+      }
+      REQUIRE(lazy.value().ordinalIndex() == eager.ordinalIndex());
+    }
+  }
+} // namespace
+
+
+TEST_CASE("Lazy accumulation of products") {
+  std::mt19937_64 engine;
+
+  SECTION("agrees with reducing every product") {
+    CheckAgainstEagerSums<SmallRingTraits>(engine);
+    CheckAgainstEagerSums<DivisionTraits>(engine);
+    CheckAgainstEagerSums<MontgomeryTraits>(engine);
+    CheckAgainstEagerSums<SpecialFormTraits>(engine);
+    CheckAgainstEagerSums<EvenRingTraits>(engine);
+  }
+
+  SECTION("multiplies polynomials over rings") {
+    using Ring = CryptoCom::CyclicRing<MontgomeryTraits>;
+    std::vector<Ring> a, b;
+    for (int idx = 0; idx < 30; ++idx)
+      a.emplace_back(int64_t(engine() >> 1));
+    for (int idx = 0; idx < 7; ++idx)
+      b.emplace_back(int64_t(engine() >> 1));
+
+    std::vector<Ring> expected(a.size() + b.size() - 1, Ring::Zero());
+    for (std::size_t i = 0; i < a.size(); ++i) {
+      for (std::size_t j = 0; j < b.size(); ++j)
+        expected[i + j] += a[i] * b[j];
+    }
+
+    auto const product = CryptoCom::Polynomial<Ring>(std::move(a)) *
+                         CryptoCom::Polynomial<Ring>(std::move(b));
+    REQUIRE(product.size() == expected.size());
+    for (std::size_t idx = 0; idx < expected.size(); ++idx)
+      REQUIRE(product[idx].ordinalIndex() == expected[idx].ordinalIndex());
+  }
+}
@@ -0,0 +1,89 @@
+#include <CryptoCom/FixedInteger.hpp>
+#include <CryptoCom/LimbArithmetic.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+
+
+namespace {
+  using CryptoCom::detail::Limb;
+
+
+  template <std::size_t N>
+  CryptoCom::FixedUInt<64 * N> RandomOperand(std::mt19937_64& engine) {
+    CryptoCom::FixedUInt<64 * N> result;
+    for (std::size_t idx = 0; idx < N; ++idx)
+      result.data()[idx] = engine();
+    return result;
+  }
+
+
+  template <std::size_t N>
+  CryptoCom::FixedUInt<128 * N> FromLimbs(Limb const* limbs) {
+    CryptoCom::FixedUInt<128 * N> result;
+    for (std::size_t idx = 0; idx < 2 * N; ++idx)
+      result.data()[idx] = limbs[idx];
+    return result;
+  }
+
+
+  template <std::size_t N>
+  void CheckProducts(std::mt19937_64& engine) {
+    using Wide = CryptoCom::FixedUInt<128 * N>;
+    // All ones operands exercise every carry path.
+    auto const a = ~CryptoCom::FixedUInt<64 * N>{};
+    for (int round = 0; round < 4; ++round) {
+      auto const b = round == 0 ? a : RandomOperand<N>(engine);
+      auto const c = round == 0 ? a : RandomOperand<N>(engine);
+      auto const expected = Wide(b) * Wide(c);
+      auto const expectedSquare = Wide(b) * Wide(b);
+
+      Limb out[2 * N];
+      CryptoCom::detail::MultiplyComba<N>(b.data(), c.data(), out);
+      REQUIRE(FromLimbs<N>(out) == expected);
+
+      CryptoCom::detail::SquareComba<N>(b.data(), out);
+      REQUIRE(FromLimbs<N>(out) == expectedSquare);
+
+      if (N > 1) {
+        CryptoCom::detail::MultiplyKaratsuba<N>(b.data(), c.data(), out);
+        REQUIRE(FromLimbs<N>(out) == expected);
+
+        CryptoCom::detail::SquareKaratsuba<N>(b.data(), out);
+        REQUIRE(FromLimbs<N>(out) == expectedSquare);
+      }
+
+      CryptoCom::detail::LimbProduct<N>::Multiply(b.data(), c.data(), out);
+      REQUIRE(FromLimbs<N>(out) == expected);
+
+      CryptoCom::detail::LimbSquare<N>::Square(b.data(), out);
+      REQUIRE(FromLimbs<N>(out) == expectedSquare);
+
+#if defined(__x86_64__)
+      if (CryptoCom::detail::HasMulxAdx()) {
+        CryptoCom::detail::MultiplyMulx<N>(b.data(), c.data(), out);
+        REQUIRE(FromLimbs<N>(out) == expected);
+      }
+#endif
+    }
+  }
+} // namespace
+
+
+TEST_CASE("Limb multiplication kernels agree with schoolbook products") {
+  std::mt19937_64 engine;
+
+  SECTION("below the Karatsuba threshold") {
+    CheckProducts<1>(engine);
+    CheckProducts<2>(engine);
+    CheckProducts<3>(engine);
+    CheckProducts<5>(engine);
+    CheckProducts<8>(engine);
+  }
+
+  SECTION("above the Karatsuba thresholds, with even and odd halves") {
+    CheckProducts<CryptoCom::detail::KaratsubaThreshold>(engine);
+    CheckProducts<CryptoCom::detail::KaratsubaThreshold + 1>(engine);
+    CheckProducts<CryptoCom::detail::KaratsubaSquareThreshold + 1>(engine);
+  }
+}
@@ -0,0 +1,152 @@
+#include <CryptoCom/ExponentialElGamal.hpp>
+#include <CryptoCom/MultiExp.hpp>
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+  struct RingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{1125899906842597}; // 2^50 - 27
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct SmallRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{1483};
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  template <typename Ring, typename Exponent>
+  Ring ProductOfPowers(
+      std::vector<Ring> const& bases, std::vector<Exponent> const& exponents) {
+    auto result = Ring::One();
+    for (std::size_t idx = 0; idx < bases.size(); ++idx)
+      result = result * bases[idx].pow(exponents[idx]);
+    return result;
+  }
+} // namespace
+
+
+TEST_CASE("Multi-exponentiation") {
+  using Ring = CryptoCom::CyclicRing<RingTraits>;
+  using Bits = CryptoCom::detail::ExponentBits<int64_t>;
+  std::mt19937_64 engine;
+
+  SECTION("agrees with multiplying the powers one by one") {
+    for (std::size_t size : {0, 1, 2, 5, 30, 200, 1000}) {
+      std::vector<Ring> bases;
+      std::vector<int64_t> exponents;
+      for (std::size_t idx = 0; idx < size; ++idx) {
+        bases.emplace_back(int64_t(engine() >> 1));
+        exponents.push_back(int64_t(engine() >> (1 + idx % 63)));
+      }
+      if (size > 2)
+        exponents[1] = 0;
+
+      REQUIRE(CryptoCom::MultiExp(bases, exponents).ordinalIndex() ==
+              ProductOfPowers(bases, exponents).ordinalIndex());
+    }
+  }
+
+  SECTION("Straus' and Pippenger's method agree at every window width") {
+    std::vector<Ring> bases;
+    std::vector<int64_t> exponents;
+    std::vector<Bits> bits;
+    for (std::size_t idx = 0; idx < 50; ++idx) {
+      bases.emplace_back(int64_t(engine() >> 1));
+      exponents.push_back(int64_t(engine() >> (1 + idx % 20)));
+      bits.emplace_back(exponents.back());
+    }
+    auto const expected = ProductOfPowers(bases, exponents).ordinalIndex();
+    for (int width = 1; width <= 8; ++width) {
+      REQUIRE(CryptoCom::detail::StrausMultiExp(bases, bits, 63, width)
+                  .ordinalIndex() == expected);
+      REQUIRE(CryptoCom::detail::PippengerMultiExp(bases, bits, 63, width)
+                  .ordinalIndex() == expected);
+    }
+  }
+
+  SECTION("picks Straus' method for few bases and Pippenger's for many") {
+    auto const cheapest = [](std::size_t const count, int const maxWidth,
+                              std::size_t (*cost)(std::size_t, int, int)) {
+      return cost(count, 256,
+          CryptoCom::detail::CheapestWidth(
+              [=](int width) { return cost(count, 256, width); }, maxWidth));
+    };
+    auto const straus = [&](std::size_t const count) {
+      return cheapest(count, CryptoCom::detail::StrausMaxWidth,
+          CryptoCom::detail::StrausCost);
+    };
+    auto const pippenger = [&](std::size_t const count) {
+      return cheapest(count, CryptoCom::detail::PippengerMaxWidth,
+          CryptoCom::detail::PippengerCost);
+    };
+    REQUIRE(straus(4) < pippenger(4));
+    REQUIRE(pippenger(1000) < straus(1000));
+  }
+
+  SECTION("takes ring elements as exponents") {
+    std::vector<Ring> bases, exponents;
+    for (int64_t idx = 0; idx < 40; ++idx) {
+      bases.emplace_back(idx + 2);
+      exponents.emplace_back(int64_t(engine() >> 1));
+    }
+    REQUIRE(CryptoCom::MultiExp(bases, exponents).ordinalIndex() ==
+            ProductOfPowers(bases, exponents).ordinalIndex());
+  }
+
+  SECTION("rejects negative exponents and missing ones") {
+    std::vector<Ring> const bases{2, 3};
+    REQUIRE_THROWS_AS(CryptoCom::MultiExp(bases, std::vector<int>{5, -1}),
+        std::invalid_argument const&);
+    REQUIRE_THROWS_AS(CryptoCom::MultiExp(bases, std::vector<int>{5}),
+        std::invalid_argument const&);
+  }
+}
+
+
+TEST_CASE("Multi-exponentiation of exponential ElGamal ciphers") {
+  using Ring = CryptoCom::CyclicRing<SmallRingTraits>;
+  using ExpElGamal = CryptoCom::ExponentialElGamal<SmallRingTraits>;
+
+  Ring privateKey, publicKey;
+  std::tie(privateKey, publicKey) =
+      ExpElGamal::KeyPairOf([]() { return Ring{5}; });
+
+  std::mt19937 engine;
+  auto const rng = [&]() { return Ring{int32_t(engine() % 1482) + 1}; };
+
+  std::vector<ExpElGamal::Cipher> ciphers;
+  std::vector<Ring> scalars;
+  auto expected = ExpElGamal::Cipher::Zero();
+  auto expectedMessage = Ring::One();
+  for (int32_t idx = 0; idx < 300; ++idx) {
+    ciphers.push_back(ExpElGamal::Encrypt(publicKey, idx % 7, rng));
+    scalars.emplace_back(int32_t(engine() % 1483));
+    expected = expected + ciphers.back() * scalars.back();
+    expectedMessage = expectedMessage *
+                      Ring::GeneratorPow(idx % 7).pow(scalars.back());
+  }
+
+  auto const combined = CryptoCom::MultiExp(ciphers, scalars);
+  REQUIRE(combined == expected);
+  REQUIRE(ExpElGamal::Decrypt(privateKey, combined).ordinalIndex() ==
+          expectedMessage.ordinalIndex());
+}
@@ -0,0 +1,203 @@
+#include <CryptoCom/NumberTheoreticTransform.hpp>
+#include <CryptoCom/Polynomial.hpp>
+#include <catch/catch.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+
+namespace {
+  struct FriendlyRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    static constexpr PrimaryType Order{998244353}; // 119 * 2^23 + 1
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+    static constexpr bool PrimeOrder = true;
+  };
+
+  constexpr int32_t FriendlyRingTraits::Order;
+
+
+  struct WideRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{4611686018427387847}; // 2^62 - 57
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr int64_t WideRingTraits::Order;
+
+
+  struct EvenRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::BarrettReduction;
+
+    static constexpr PrimaryType Order{2250635938};
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr int64_t EvenRingTraits::Order;
+
+
+  static_assert(
+      CryptoCom::NumberTheoreticTransform<FriendlyRingTraits>::MaxLogSize == 23,
+      "998244353 - 1 = 119 * 2^23");
+  static_assert(
+      CryptoCom::NumberTheoreticTransform<WideRingTraits>::MaxLogSize == 0,
+      "without a transform of its own the ring takes the CRT");
+
+
+  template <typename Traits>
+  std::vector<CryptoCom::CyclicRing<Traits>> RandomElements(
+      std::size_t const count, std::mt19937_64& engine) {
+    using Primary = typename Traits::PrimaryType;
+    std::vector<CryptoCom::CyclicRing<Traits>> elements;
+    for (std::size_t idx = 0; idx < count; ++idx) {
+      // The largest residues now and then, for the largest coefficients.
+      elements.emplace_back(idx % 3 == 0
+                                ? Primary(Traits::Order - 1)
+                                : Primary(engine() % Traits::Order));
+    }
+    return elements;
+  }
+
+
+  template <typename Traits>
+  void CheckAgainstSchoolbook(std::mt19937_64& engine) {
+    using Ring = CryptoCom::CyclicRing<Traits>;
+    for (std::size_t n : {1, 2, 127, 513, 1000}) {
+      for (std::size_t m : {1, 512, 600, 1500}) {
+        auto const a = RandomElements<Traits>(n, engine);
+        auto const b = RandomElements<Traits>(m, engine);
+        std::vector<Ring> expected(n + m - 1), product(n + m - 1);
+        CryptoCom::detail::SchoolbookProduct(
+            a.data(), n, b.data(), m, expected.data());
+        CryptoCom::detail::PolynomialProduct(
+            a.data(), n, b.data(), m, product.data());
+        for (std::size_t k = 0; k < expected.size(); ++k)
+          REQUIRE(product[k].ordinalIndex() == expected[k].ordinalIndex());
+      }
+    }
+  }
+} // namespace
+
+
+TEST_CASE("Number-theoretic transforms") {
+  using Ring = CryptoCom::CyclicRing<FriendlyRingTraits>;
+  using Transform = CryptoCom::NumberTheoreticTransform<FriendlyRingTraits>;
+  std::mt19937_64 engine;
+
+  SECTION("are inverted by the inverse transform") {
+    for (std::size_t size : {1, 2, 4, 8, 32, 1024, 2048}) {
+      auto const values = RandomElements<FriendlyRingTraits>(size, engine);
+      auto transformed = values;
+      Transform::Forward(transformed.data(), size);
+      Transform::Inverse(transformed.data(), size);
+      for (std::size_t idx = 0; idx < size; ++idx) {
+        REQUIRE(transformed[idx].ordinalIndex() ==
+                values[idx].ordinalIndex());
+      }
+    }
+  }
+
+  SECTION("evaluate at the powers of a root of unity") {
+    std::vector<Ring> values{1, 2, 3, 4, 5, 6, 7, 8};
+    auto transformed = values;
+    Transform::Forward(transformed.data(), values.size());
+
+    auto const root = Ring{int32_t(
+        CryptoCom::detail::TransformParameters<FriendlyRingTraits>::Root)};
+    auto const w = root.pow(int64_t(1) << (Transform::MaxLogSize - 3));
+    REQUIRE(w.pow(4).ordinalIndex() == FriendlyRingTraits::Order - 1);
+
+    auto const polynomial = CryptoCom::Polynomial<Ring>(std::move(values));
+    for (std::size_t idx = 0; idx < 8; ++idx) {
+      // Bit reversed order of the points.
+      auto const reversed = ((idx & 1) << 2) | (idx & 2) | ((idx & 4) >> 2);
+      REQUIRE(transformed[reversed].ordinalIndex() ==
+              polynomial(w.pow(int64_t(idx))).ordinalIndex());
+    }
+  }
+
+  SECTION("are doubled by the transform of the twisted coefficients") {
+    auto const coefficients = RandomElements<FriendlyRingTraits>(300, engine);
+    std::vector<Ring> values(1024, Ring::Zero()), expected(1024, Ring::Zero());
+    std::copy(coefficients.begin(), coefficients.end(), values.begin());
+    std::copy(coefficients.begin(), coefficients.end(), expected.begin());
+    Transform::Forward(values.data(), 512);
+    Transform::Forward(expected.data(), 1024);
+
+    Transform::Extend(coefficients.data(), 300, values.data(), 512);
+    for (std::size_t idx = 0; idx < 1024; ++idx)
+      REQUIRE(values[idx].ordinalIndex() == expected[idx].ordinalIndex());
+  }
+
+  SECTION("multiply polynomials over rings of a suitable prime order") {
+    CheckAgainstSchoolbook<FriendlyRingTraits>(engine);
+  }
+
+  SECTION("multiply polynomials over any other word sized ring by the CRT") {
+    CheckAgainstSchoolbook<WideRingTraits>(engine);
+    CheckAgainstSchoolbook<EvenRingTraits>(engine);
+  }
+
+  SECTION("reuse the values of chained products of polynomials") {
+    using Poly = CryptoCom::Polynomial<Ring>;
+    std::vector<std::vector<Ring>> factors;
+    for (std::size_t size : {100, 90, 200, 700, 64})
+      factors.push_back(RandomElements<FriendlyRingTraits>(size, engine));
+
+    // (f0 f1) needs 256 points, (f0 f1) f2 512 from the doubled 256,
+    // ((f0 f1) f2) f3 2048 from scratch, and the last one fits those.
+    auto product = Poly(std::vector<Ring>(factors[0])) *
+                   Poly(std::vector<Ring>(factors[1]));
+    auto expected = factors[0];
+    for (std::size_t idx = 1; idx < factors.size(); ++idx) {
+      if (idx > 1)
+        product = product * Poly(std::vector<Ring>(factors[idx]));
+      std::vector<Ring> next(expected.size() + factors[idx].size() - 1);
+      CryptoCom::detail::SchoolbookProduct(expected.data(), expected.size(),
+          factors[idx].data(), factors[idx].size(), next.data());
+      expected = std::move(next);
+    }
+
+    REQUIRE(product.size() == expected.size());
+    for (std::size_t k = 0; k < expected.size(); ++k)
+      REQUIRE(product[k].ordinalIndex() == expected[k].ordinalIndex());
+
+    SECTION("until their coefficients are written to") {
+      auto changed = product;
+      changed[0] = changed[0] + Ring::One();
+      Poly const ones(std::vector<Ring>(200, Ring::One()));
+      REQUIRE(((changed * ones)[0] - (product * ones)[0]).ordinalIndex() == 1);
+    }
+
+    SECTION("whose const reads leave them unchanged") {
+      Poly const& view = product;
+      auto const copy = product;
+      Poly const ones(std::vector<Ring>(200, Ring::One()));
+      auto const first = view * ones;
+      for (std::size_t k = 0; k < expected.size(); ++k)
+        REQUIRE(view[k].ordinalIndex() == expected[k].ordinalIndex());
+      REQUIRE((view == copy));
+      REQUIRE((view * ones == first));
+      REQUIRE((copy * ones == first));
+      REQUIRE(std::equal(view.cbegin(), view.cend(), expected.cbegin()));
+    }
+  }
+}
@@ -1,6 +1,11 @@
 #include <CryptoCom/Polynomial.hpp>
 #include <catch/catch.hpp>
 
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
 namespace CryptoCom {
   std::ostream& operator<<(std::ostream& ostr, Polynomial<int> const& p) {
     ostr << "{ ";
@@ -40,4 +45,59 @@ TEST_CASE("Generic polynomials") {
     CryptoCom::Polynomial<int> expected{36, -13, 1};
     REQUIRE(p == expected);
   }
+
+
+  SECTION("the subproduct tree agrees with one factor at a time") {
+    std::vector<int> roots;
+    for (int count = 1; count <= 11; ++count) {
+      roots.push_back(count % 2 == 0 ? count : -count);
+      CryptoCom::Polynomial<int> expected{-roots[0], 1};
+      for (size_t idx = 1; idx < roots.size(); ++idx)
+        expected = expected * CryptoCom::Polynomial<int>{-roots[idx], 1};
+
+      auto const p = CryptoCom::Polynomial<int>::fromRoots(
+          roots.cbegin(), roots.cend());
+      REQUIRE(p == expected);
+      for (auto const root : roots)
+        CHECK(p(root) == 0);
+    }
+  }
+
+
+  SECTION("Karatsuba's method agrees with the schoolbook method") {
+    std::mt19937 engine;
+    std::vector<int64_t> a(300), b(300), expected(600), actual(600);
+    for (auto& coefficient : a)
+      coefficient = int64_t(engine() % 2001) - 1000;
+    for (auto& coefficient : b)
+      coefficient = int64_t(engine() % 2001) - 1000;
+
+    for (size_t n : {1, 47, 48, 49, 97, 130, 300}) {
+      for (size_t m : {1, 48, 60, 97, 211, 300}) {
+        CryptoCom::detail::SchoolbookProduct(
+            a.data(), n, b.data(), m, expected.data());
+        CryptoCom::detail::PolynomialProduct(
+            a.data(), n, b.data(), m, actual.data());
+        REQUIRE(std::equal(expected.begin(), expected.begin() + (n + m - 1),
+            actual.begin()));
+      }
+    }
+  }
+
+
+  SECTION("an empty operand makes a product of zeros") {
+    CryptoCom::Polynomial<int> const empty{};
+    CryptoCom::Polynomial<int> const polynomial{2, 1, 3};
+    REQUIRE(empty * polynomial == (CryptoCom::Polynomial<int>{0, 0}));
+    REQUIRE(polynomial * empty == (CryptoCom::Polynomial<int>{0, 0}));
+    REQUIRE((empty * empty).size() == 0);
+  }
+
+
+  SECTION("no roots at all make the constant one") {
+    std::vector<int> const roots;
+    auto const p =
+        CryptoCom::Polynomial<int>::fromRoots(roots.cbegin(), roots.cend());
+    REQUIRE(p == CryptoCom::Polynomial<int>{1});
+  }
 }
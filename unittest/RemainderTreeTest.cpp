@@ -0,0 +1,155 @@
+#include <CryptoCom/ExponentialElGamal.hpp>
+#include <CryptoCom/ObliviousEvaluation.hpp>
+#include <CryptoCom/RemainderTree.hpp>
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+
+namespace {
+  struct SmallRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{1483};
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+    static constexpr bool PrimeOrder = true;
+  };
+
+
+  // The safe prime p = 2 q + 1 below 2^32 and its subgroup of squares.
+  struct SchnorrGroupTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::BarrettReduction;
+
+    static constexpr PrimaryType Order{4294967087};
+    static constexpr PrimaryType SubgroupOrder{2147483543};
+    static constexpr PrimaryType Generator{4};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  // A composite order, 3^(n - 1) = 3 mod n, so exponents have no modulus
+  // that the tree could reduce them by.
+  struct CompositeRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{2250635938};
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  template <typename Traits>
+  void CheckAgainstHorner(std::size_t const points, std::size_t const degree,
+      std::mt19937_64& engine) {
+    using Ring = CryptoCom::CyclicRing<Traits>;
+    using Encryption = CryptoCom::ExponentialElGamal<Traits>;
+    using Cipher = typename Encryption::Cipher;
+    auto const rng = [&]() {
+      return Ring{typename Traits::PrimaryType(
+          engine() % (Traits::Order - 1) + 1)};
+    };
+
+    Ring privateKey, publicKey;
+    std::tie(privateKey, publicKey) = Encryption::KeyPairOf(rng);
+    std::vector<Cipher> coefficients;
+    for (std::size_t idx = 0; idx <= degree; ++idx) {
+      coefficients.push_back(Encryption::Encrypt(
+          publicKey, int32_t(engine() % 1000) - 500, rng));
+    }
+    CryptoCom::Polynomial<Cipher> const polynomial{std::move(coefficients)};
+
+    std::vector<int32_t> elements;
+    for (std::size_t idx = 0; idx < points; ++idx)
+      elements.push_back(int32_t(engine() % 1483));
+
+    CryptoCom::RemainderTree<Traits, int32_t> const tree(
+        elements.begin(), elements.end());
+    auto const values = tree.evaluate(polynomial);
+    REQUIRE(values.size() == points);
+    for (std::size_t idx = 0; idx < points; ++idx)
+      REQUIRE(values[idx] == polynomial(elements[idx]));
+  }
+
+
+  // A server with 100 elements and a client polynomial of degree 99, so
+  // that a ring with a remainder tree evaluates by it.
+  template <typename Traits>
+  void CheckServerAgainstHorner(std::mt19937_64& engine) {
+    using Ring = CryptoCom::CyclicRing<Traits>;
+    using Encryption = CryptoCom::ExponentialElGamal<Traits>;
+    using Cipher = typename Encryption::Cipher;
+    auto const draw = [](std::mt19937_64& source) {
+      return Ring{int64_t(source() % (Traits::Order - 1) + 1)};
+    };
+    auto const rng = [&]() { return draw(engine); };
+
+    Ring privateKey, publicKey;
+    std::tie(privateKey, publicKey) = Encryption::KeyPairOf(rng);
+    std::vector<Cipher> coefficients;
+    for (int32_t idx = 0; idx < 100; ++idx)
+      coefficients.push_back(Encryption::Encrypt(publicKey, idx, rng));
+    CryptoCom::Polynomial<Cipher> const polynomial{std::move(coefficients)};
+
+    std::set<int32_t> elements;
+    for (int32_t idx = 0; idx < 100; ++idx)
+      elements.insert(7 * idx);
+
+    // The same masks for the server as for Horner's scheme.
+    std::mt19937_64 masks, sameMasks;
+    CryptoCom::ObliviousEvaluation::ServerSet<Ring, int32_t> const server{
+        elements};
+    auto const evaluated =
+        server.evaluate(polynomial, [&]() { return draw(masks); });
+
+    std::set<Cipher> expected;
+    for (auto const element : elements)
+      expected.insert(polynomial(element) * draw(sameMasks) + Ring{element});
+    REQUIRE((evaluated == expected));
+  }
+} // namespace
+
+
+TEST_CASE("Evaluating encrypted polynomials by a remainder tree") {
+  std::mt19937_64 engine;
+
+  SECTION("agrees with Horner's scheme at every point") {
+    for (std::size_t points : {1, 15, 17, 100, 300}) {
+      for (std::size_t degree : {1, 16, 70, 300}) {
+        CheckAgainstHorner<SmallRingTraits>(points, degree, engine);
+        CheckAgainstHorner<SchnorrGroupTraits>(points, degree, engine);
+      }
+    }
+  }
+
+  SECTION("evaluates for servers with large sets") {
+    using Ring = CryptoCom::CyclicRing<SchnorrGroupTraits>;
+    using Cipher = CryptoCom::ExponentialElGamal<SchnorrGroupTraits>::Cipher;
+    using HasTree =
+        CryptoCom::ObliviousEvaluation::detail::HasRemainderTree<Ring, Cipher>;
+    REQUIRE(HasTree::value);
+    CheckServerAgainstHorner<SchnorrGroupTraits>(engine);
+  }
+
+  SECTION("leaves servers over composite orders to Horner's scheme") {
+    using Ring = CryptoCom::CyclicRing<CompositeRingTraits>;
+    using Cipher = CryptoCom::ExponentialElGamal<CompositeRingTraits>::Cipher;
+    using HasTree =
+        CryptoCom::ObliviousEvaluation::detail::HasRemainderTree<Ring, Cipher>;
+    REQUIRE_FALSE(HasTree::value);
+    CheckServerAgainstHorner<CompositeRingTraits>(engine);
+  }
+}
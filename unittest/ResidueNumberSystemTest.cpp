@@ -0,0 +1,163 @@
+#include <CryptoCom/CyclicRing.hpp>
+#include <CryptoCom/ElGamal.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+#include <set>
+
+
+namespace {
+  struct ResidueRingTraits {
+    using PrimaryType = CryptoCom::FixedUInt<256>;
+    using EscalationType = CryptoCom::FixedUInt<512>;
+    using CoefficientType = CryptoCom::FixedInt<320>;
+    using Reduction = CryptoCom::ResidueNumberSystem;
+
+    // 2^255 - 19
+    static constexpr PrimaryType Order = PrimaryType::FromHex(
+        "7fffffffffffffff'ffffffffffffffff'ffffffffffffffff'ffffffffffffffed");
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr ResidueRingTraits::PrimaryType ResidueRingTraits::Order;
+  constexpr ResidueRingTraits::PrimaryType ResidueRingTraits::Generator;
+  constexpr ResidueRingTraits::PrimaryType ResidueRingTraits::AdditiveIdentity;
+  constexpr ResidueRingTraits::PrimaryType
+      ResidueRingTraits::MultiplicativeIdentity;
+
+
+  struct LimbRingTraits : public ResidueRingTraits {
+    using Reduction = CryptoCom::MontgomeryReduction;
+  };
+
+
+  // The Mersenne prime 2^521 - 1, an order spanning several vector registers
+  // of lanes.
+  struct WideResidueRingTraits {
+    using PrimaryType = CryptoCom::FixedUInt<576>;
+    using EscalationType = CryptoCom::FixedUInt<1152>;
+    using CoefficientType = CryptoCom::FixedInt<640>;
+    using Reduction = CryptoCom::ResidueNumberSystem;
+
+    static constexpr PrimaryType Order = (PrimaryType(1) << 521) - 1;
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr WideResidueRingTraits::PrimaryType WideResidueRingTraits::Order;
+  constexpr WideResidueRingTraits::PrimaryType
+      WideResidueRingTraits::Generator;
+  constexpr WideResidueRingTraits::PrimaryType
+      WideResidueRingTraits::AdditiveIdentity;
+  constexpr WideResidueRingTraits::PrimaryType
+      WideResidueRingTraits::MultiplicativeIdentity;
+
+
+  struct WideLimbRingTraits : public WideResidueRingTraits {
+    using Reduction = CryptoCom::MontgomeryReduction;
+  };
+
+
+  template <std::size_t Bits>
+  CryptoCom::FixedUInt<Bits> RandomInteger(std::mt19937_64& engine) {
+    CryptoCom::FixedUInt<Bits> result;
+    for (std::size_t idx = 0; idx < CryptoCom::FixedUInt<Bits>::LimbCount;
+         ++idx)
+      result.data()[idx] = engine();
+    return result;
+  }
+} // namespace
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<ResidueRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+} // namespace CryptoCom
+
+
+TEST_CASE("Cyclic rings in residue number system representation") {
+  using Ring = CryptoCom::CyclicRing<ResidueRingTraits>;
+  using LimbRing = CryptoCom::CyclicRing<LimbRingTraits>;
+  std::mt19937_64 engine;
+
+  SECTION("integers round trip through the residues") {
+    REQUIRE(Ring{0}.ordinalIndex() == 0);
+    REQUIRE(Ring{1}.ordinalIndex() == 1);
+    REQUIRE(Ring{ResidueRingTraits::Order - 1}.ordinalIndex() ==
+            ResidueRingTraits::Order - 1);
+    REQUIRE(Ring{ResidueRingTraits::Order}.ordinalIndex() == 0);
+  }
+
+  SECTION("arithmetic agrees with the limb representation") {
+    for (int idx = 0; idx < 50; ++idx) {
+      auto const a = RandomInteger<256>(engine);
+      auto const b = RandomInteger<256>(engine);
+      Ring const x{a}, y{b};
+      LimbRing const u{a}, v{b};
+      REQUIRE((x * y).ordinalIndex() == (u * v).ordinalIndex());
+      REQUIRE(x.square().ordinalIndex() == u.square().ordinalIndex());
+      REQUIRE((x + y).ordinalIndex() == (u + v).ordinalIndex());
+      REQUIRE((x - y).ordinalIndex() == (u - v).ordinalIndex());
+      REQUIRE((-x).ordinalIndex() == (-u).ordinalIndex());
+    }
+  }
+
+  SECTION("long chains of operations stay bounded") {
+    auto const a = RandomInteger<256>(engine);
+    Ring x{a};
+    LimbRing u{a};
+    for (int idx = 0; idx < 200; ++idx) {
+      x = (x * x + x) - Ring{idx};
+      u = (u * u + u) - LimbRing{idx};
+    }
+    REQUIRE(x.ordinalIndex() == u.ordinalIndex());
+  }
+
+  SECTION("equal elements compare equal whatever their residues") {
+    auto const a = Ring{RandomInteger<256>(engine)};
+    auto const b = Ring{RandomInteger<256>(engine)};
+    REQUIRE(a * b == b * a);
+    REQUIRE((a + b) - b == a);
+    REQUIRE(a * b * b.inverse() == a);
+
+    std::set<Ring> const elements{a * b, b * a, a, (a + b) - b};
+    REQUIRE(elements.size() == 2);
+  }
+
+  SECTION("Fermat's little theorem holds") {
+    auto const a = Ring{RandomInteger<256>(engine)};
+    REQUIRE(a.pow(ResidueRingTraits::Order - 1) == Ring::One());
+  }
+
+  SECTION("ElGamal encryption round trips") {
+    using EncryptionScheme = CryptoCom::ElGamal<ResidueRingTraits>;
+    auto const secret = Ring{RandomInteger<256>(engine)};
+    auto const nonce = Ring{RandomInteger<256>(engine)};
+
+    Ring privateKey, publicKey;
+    std::tie(privateKey, publicKey) =
+        EncryptionScheme::KeyPairOf([&secret]() { return secret; });
+    auto const cipher = EncryptionScheme::Encrypt(
+        publicKey, 42, [&nonce]() { return nonce; });
+    REQUIRE(EncryptionScheme::Decrypt(privateKey, cipher) == 42);
+  }
+
+  SECTION("orders spanning several vector registers") {
+    using WideRing = CryptoCom::CyclicRing<WideResidueRingTraits>;
+    using WideLimbRing = CryptoCom::CyclicRing<WideLimbRingTraits>;
+    for (int idx = 0; idx < 20; ++idx) {
+      auto const a = RandomInteger<576>(engine) >> 56;
+      auto const b = RandomInteger<576>(engine) >> 56;
+      REQUIRE((WideRing{a} * WideRing{b}).ordinalIndex() ==
+              (WideLimbRing{a} * WideLimbRing{b}).ordinalIndex());
+      REQUIRE((WideRing{a} - WideRing{b}).ordinalIndex() ==
+              (WideLimbRing{a} - WideLimbRing{b}).ordinalIndex());
+    }
+  }
+}
@@ -0,0 +1,180 @@
+#include <CryptoCom/RingVector.hpp>
+#include <catch/catch.hpp>
+
+#include <cstdint>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+
+namespace {
+  struct LaneRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::MontgomeryReduction;
+
+    static constexpr PrimaryType Order{2147483629}; // 2^31 - 19
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  struct SmallRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int32_t;
+
+    static constexpr PrimaryType Order{37};
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  // Even, so kept as an array of ring elements.
+  struct EvenRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+    using Reduction = CryptoCom::BarrettReduction;
+
+    static constexpr PrimaryType Order{2250635938};
+    static constexpr PrimaryType Generator{3};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  static_assert(CryptoCom::detail::HasLaneOrder<LaneRingTraits>::value &&
+                    CryptoCom::detail::HasLaneOrder<SmallRingTraits>::value &&
+                    !CryptoCom::detail::HasLaneOrder<EvenRingTraits>::value,
+      "only odd orders below 2^31 fit the lanes");
+
+
+  template <typename Traits>
+  std::vector<CryptoCom::CyclicRing<Traits>> RandomElements(
+      std::mt19937_64& engine, std::size_t const count) {
+    std::vector<CryptoCom::CyclicRing<Traits>> elements;
+    for (std::size_t idx = 0; idx < count; ++idx)
+      elements.emplace_back(typename Traits::PrimaryType(engine() >> 1));
+    return elements;
+  }
+
+
+  // Checks every element-wise operation against the ring's own arithmetic
+  // for all sizes up to a few vector registers, so that every tail occurs.
+  template <typename Traits>
+  void CheckAgainstRing(std::mt19937_64& engine) {
+    using Ring = CryptoCom::CyclicRing<Traits>;
+    using Vector = CryptoCom::RingVector<Traits>;
+    for (std::size_t size = 0; size < 50; ++size) {
+      auto const a = RandomElements<Traits>(engine, size);
+      auto const b = RandomElements<Traits>(engine, size);
+      Ring const scalar{typename Traits::PrimaryType(engine() >> 1)};
+      Vector const x(a.cbegin(), a.cend()), y(b.cbegin(), b.cend());
+      auto const sum = x + y, difference = x - y, product = x * y,
+                 scaled = x * scalar;
+
+      auto dot = Ring::Zero(), total = Ring::Zero();
+      for (std::size_t idx = 0; idx < size; ++idx) {
+        REQUIRE(x[idx].ordinalIndex() == a[idx].ordinalIndex());
+        REQUIRE(sum[idx].ordinalIndex() == (a[idx] + b[idx]).ordinalIndex());
+        REQUIRE(difference[idx].ordinalIndex() ==
+                (a[idx] - b[idx]).ordinalIndex());
+        REQUIRE(product[idx].ordinalIndex() ==
+                (a[idx] * b[idx]).ordinalIndex());
+        REQUIRE(scaled[idx].ordinalIndex() ==
+                (a[idx] * scalar).ordinalIndex());
+        dot += a[idx] * b[idx];
+        total += a[idx];
+      }
+      REQUIRE(x.dot(y).ordinalIndex() == dot.ordinalIndex());
+      REQUIRE(x.sum().ordinalIndex() == total.ordinalIndex());
+    }
+  }
+} // namespace
+
+
+TEST_CASE("Ring vectors") {
+  std::mt19937_64 engine;
+
+  SECTION("agree with the ring's arithmetic element by element") {
+    CheckAgainstRing<LaneRingTraits>(engine);
+    CheckAgainstRing<SmallRingTraits>(engine);
+    CheckAgainstRing<EvenRingTraits>(engine);
+  }
+
+  SECTION("keep the largest residues reduced") {
+    using Vector = CryptoCom::RingVector<LaneRingTraits>;
+    std::vector<int64_t> const minusOnes(33, -1);
+    Vector const x(minusOnes.cbegin(), minusOnes.cend());
+    auto const square = x * x, doubled = x + x;
+    for (std::size_t idx = 0; idx < x.size(); ++idx) {
+      REQUIRE(square[idx].ordinalIndex() == 1);
+      REQUIRE(doubled[idx].ordinalIndex() == LaneRingTraits::Order - 2);
+    }
+    REQUIRE(x.dot(x).ordinalIndex() == 33);
+    REQUIRE((Vector(33) - x).sum().ordinalIndex() == 33);
+  }
+
+  SECTION("elements can be replaced") {
+    CryptoCom::RingVector<SmallRingTraits> x{1, 2, 3};
+    x.set(1, 30);
+    REQUIRE(x == (CryptoCom::RingVector<SmallRingTraits>{1, 30, 3}));
+    REQUIRE(x.sum().ordinalIndex() == 34);
+  }
+
+  SECTION("vectors of different size are rejected") {
+    CryptoCom::RingVector<SmallRingTraits> const x{1, 2, 3}, y{1, 2};
+    REQUIRE_THROWS_AS(x + y, std::invalid_argument const&);
+    REQUIRE_THROWS_AS(x.dot(y), std::invalid_argument const&);
+  }
+}
+
+
+TEST_CASE("Vector lane kernels agree with the scalar ones") {
+  using CryptoCom::detail::Residue;
+  CryptoCom::detail::LaneModulus const m{2147483629};
+  std::mt19937_64 engine;
+
+  std::vector<Residue> a(101), b(101);
+  for (std::size_t idx = 0; idx < a.size(); ++idx) {
+    a[idx] = Residue(engine() % m.modulus);
+    b[idx] = Residue(engine() % m.modulus);
+  }
+  a[0] = b[0] = m.modulus - 1;
+
+  auto const check = [&](auto kernels) {
+    using Kernels = decltype(kernels);
+    using Scalar = CryptoCom::detail::ScalarLanes;
+    std::vector<Residue> expected(a.size()), actual(a.size());
+    for (std::size_t size : {std::size_t(0), std::size_t(7),
+             std::size_t(16), std::size_t(101)}) {
+      Scalar::Add(expected.data(), a.data(), b.data(), size, m);
+      Kernels::Add(actual.data(), a.data(), b.data(), size, m);
+      REQUIRE(expected == actual);
+      Scalar::Subtract(expected.data(), a.data(), b.data(), size, m);
+      Kernels::Subtract(actual.data(), a.data(), b.data(), size, m);
+      REQUIRE(expected == actual);
+      Scalar::Multiply(expected.data(), a.data(), b.data(), size, m);
+      Kernels::Multiply(actual.data(), a.data(), b.data(), size, m);
+      REQUIRE(expected == actual);
+      Scalar::MultiplyScalar(expected.data(), a.data(), b[3], size, m);
+      Kernels::MultiplyScalar(actual.data(), a.data(), b[3], size, m);
+      REQUIRE(expected == actual);
+      REQUIRE(Kernels::Dot(a.data(), b.data(), size, m) ==
+              Scalar::Dot(a.data(), b.data(), size, m));
+      REQUIRE(Kernels::Sum(a.data(), size, m) ==
+              Scalar::Sum(a.data(), size, m));
+    }
+  };
+
+#if defined(__x86_64__)
+  if (__builtin_cpu_supports("avx2"))
+    check(CryptoCom::detail::Avx2Lanes{});
+  if (__builtin_cpu_supports("avx512f"))
+    check(CryptoCom::detail::Avx512Lanes{});
+#endif
+  check(CryptoCom::detail::ScalarLanes{});
+}
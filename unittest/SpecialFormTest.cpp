@@ -0,0 +1,184 @@
+#include <CryptoCom/CyclicRing.hpp>
+#include <catch/catch.hpp>
+
+#include <random>
+#include <type_traits>
+
+
+namespace {
+  struct MersenneRingTraits {
+    using PrimaryType = int64_t;
+    using EscalationType = CryptoCom::UInt128;
+    using CoefficientType = int64_t;
+
+    static constexpr PrimaryType Order{(int64_t(1) << 61) - 1};
+    static constexpr PrimaryType Generator{37};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+
+  // 2^62 - 2^16 + 1
+  struct SolinasRingTraits : public MersenneRingTraits {
+    using Reduction = CryptoCom::SpecialFormReduction;
+    static constexpr PrimaryType Order{
+        (int64_t(1) << 62) - (int64_t(1) << 16) + 1};
+  };
+
+
+  struct SmallRingTraits {
+    using PrimaryType = int32_t;
+    using EscalationType = int64_t;
+    using CoefficientType = int32_t;
+
+    static constexpr PrimaryType Order{(1 << 13) - 1};
+    static constexpr PrimaryType Generator{17};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  struct SmallSpecialRingTraits : public SmallRingTraits {
+    using Reduction = CryptoCom::SpecialFormReduction;
+  };
+
+
+  struct LimbRingTraits {
+    using PrimaryType = CryptoCom::FixedUInt<256>;
+    using EscalationType = CryptoCom::FixedUInt<512>;
+    using CoefficientType = CryptoCom::FixedInt<320>;
+
+    // 2^255 - 19
+    static constexpr PrimaryType Order = PrimaryType::FromHex(
+        "7fffffffffffffff'ffffffffffffffff'ffffffffffffffff'ffffffffffffffed");
+    static constexpr PrimaryType Generator{2};
+    static constexpr PrimaryType AdditiveIdentity{0};
+    static constexpr PrimaryType MultiplicativeIdentity{1};
+  };
+
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::Order;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::Generator;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::AdditiveIdentity;
+  constexpr LimbRingTraits::PrimaryType LimbRingTraits::MultiplicativeIdentity;
+
+
+  struct MontgomeryLimbRingTraits : public LimbRingTraits {
+    using Reduction = CryptoCom::MontgomeryReduction;
+  };
+
+
+  template <typename Traits>
+  using TagOf = typename CryptoCom::detail::ReductionTagOf<Traits>::type;
+
+  static_assert(std::is_same<TagOf<MersenneRingTraits>,
+                    CryptoCom::SpecialFormReduction>::value,
+      "Mersenne orders are detected");
+  static_assert(std::is_same<TagOf<LimbRingTraits>,
+                    CryptoCom::SpecialFormReduction>::value,
+      "pseudo-Mersenne orders are detected");
+  static_assert(std::is_same<TagOf<SmallRingTraits>,
+                    CryptoCom::DivisionReduction>::value,
+      "small orders reduce in special form only when they ask to");
+  static_assert(!CryptoCom::detail::IsSpecialForm(uint32_t{37}) &&
+                    !CryptoCom::detail::IsSpecialForm(uint32_t{1000003}) &&
+                    !CryptoCom::detail::IsSpecialForm(uint32_t{1u << 20}),
+      "other orders are not");
+
+
+  int64_t MultiplyModulo(int64_t const a, int64_t const b, int64_t const n) {
+    return int64_t(CryptoCom::UInt128(a) * CryptoCom::UInt128(b) %
+                   CryptoCom::UInt128(n));
+  }
+} // namespace
+
+
+namespace CryptoCom {
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<MersenneRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<SmallSpecialRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+
+  std::ostream& operator<<(
+      std::ostream& ostr, CyclicRing<LimbRingTraits> const& e) {
+    ostr << e.ordinalIndex();
+    return ostr;
+  }
+} // namespace CryptoCom
+
+
+TEST_CASE("In cyclic rings of a special form order") {
+  std::mt19937_64 engine;
+
+  SECTION("products modulo a Mersenne prime are reduced fully") {
+    using Ring = CryptoCom::CyclicRing<MersenneRingTraits>;
+    int64_t const order = MersenneRingTraits::Order;
+    int64_t const samples[] = {0, 1, 2, (int64_t(1) << 60) + 5, order - 2,
+        order - 1};
+    for (auto const a : samples) {
+      for (auto const b : samples) {
+        REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+                MultiplyModulo(a, b, order));
+      }
+    }
+
+    for (int idx = 0; idx < 1000; ++idx) {
+      auto const a = int64_t(engine() >> 3);
+      auto const b = int64_t(engine() >> (3 + idx % 60));
+      REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+              MultiplyModulo(a % order, b % order, order));
+    }
+    REQUIRE(Ring{3}.pow(order - 1) == Ring::One());
+  }
+
+  SECTION("products modulo a Solinas prime are reduced fully") {
+    using Ring = CryptoCom::CyclicRing<SolinasRingTraits>;
+    int64_t const order = SolinasRingTraits::Order;
+    for (int idx = 0; idx < 1000; ++idx) {
+      auto const a = int64_t(engine() >> 2) % order;
+      auto const b = int64_t(engine() >> (2 + idx % 61)) % order;
+      REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+              MultiplyModulo(a, b, order));
+      REQUIRE((Ring{a} - Ring{b}).ordinalIndex() ==
+              (a >= b ? a - b : a - b + order));
+    }
+  }
+
+  SECTION("small rings reduce within their EscalationType") {
+    using Ring = CryptoCom::CyclicRing<SmallSpecialRingTraits>;
+    for (int32_t a = 0; a < SmallRingTraits::Order; a += 71) {
+      for (int32_t b = 0; b < SmallRingTraits::Order; b += 113) {
+        REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+                a * b % SmallRingTraits::Order);
+      }
+    }
+    REQUIRE(Ring{-1} * Ring{-1} == Ring::One());
+  }
+
+  SECTION("fixed width products agree with Montgomery form") {
+    using Ring = CryptoCom::CyclicRing<LimbRingTraits>;
+    using MontgomeryRing = CryptoCom::CyclicRing<MontgomeryLimbRingTraits>;
+    auto const minusOne = Ring{LimbRingTraits::Order - 1};
+    REQUIRE(minusOne * minusOne == Ring::One());
+    REQUIRE(minusOne.square() == Ring::One());
+
+    for (int idx = 0; idx < 100; ++idx) {
+      LimbRingTraits::PrimaryType a, b;
+      for (std::size_t limb = 0; limb < a.LimbCount; ++limb) {
+        a.data()[limb] = engine();
+        b.data()[limb] = engine();
+      }
+      REQUIRE((Ring{a} * Ring{b}).ordinalIndex() ==
+              (MontgomeryRing{a} * MontgomeryRing{b}).ordinalIndex());
+      REQUIRE(Ring{a}.square().ordinalIndex() ==
+              MontgomeryRing{a}.square().ordinalIndex());
+      REQUIRE(Ring::GeneratorPow(b).ordinalIndex() ==
+              MontgomeryRing::GeneratorPow(b).ordinalIndex());
+    }
+  }
+}